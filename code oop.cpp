@@ -1,282 +1,689 @@
-#include <array>
-#include <iostream>
-#include <stdexcept>
-#include <sstream>
-#include <type_traits>
-
-// Допоміжна структура для двочкового просування типів
-template<typename A, typename B>
-using Promote = decltype(std::declval<A>() + std::declval<B>());
-
-template<typename... Ts>
-struct PromoteMultiple;
-
-template<typename T>
-struct PromoteMultiple<T> {
-    using type = T;
-};
-
-template<typename A, typename B, typename... Rest>
-struct PromoteMultiple<A, B, Rest...> {
-    using type = typename PromoteMultiple<
-        std::common_type_t<A, B>, Rest...
-    >::type;
-};
-
-template<typename T, std::size_t N>
-class Vector {
-public:
-    using value_type = T;
-    static constexpr std::size_t dimension = N;
-
-    Vector() { data_.fill(T{}); }
-    explicit Vector(const T& value) { data_.fill(value); }
-    Vector(const Vector& other) = default;
-
-    template<typename U>
-    Vector(const Vector<U, N>& other) {
-        for (std::size_t i = 0; i < N; ++i)
-            data_[i] = static_cast<T>(other[i]);
-    }
-
-    Vector& operator=(const Vector& other) = default;
-
-    T& operator[](int index) { return data_[normalize_index(index)]; }
-    const T& operator[](int index) const { return data_[normalize_index(index)]; }
-
-    constexpr std::size_t size() const noexcept { return N; }
-
-    auto begin() noexcept { return data_.begin(); }
-    auto end() noexcept { return data_.end(); }
-    auto begin() const noexcept { return data_.begin(); }
-    auto end() const noexcept { return data_.end(); }
-
-    friend std::ostream& operator<<(std::ostream& os, const Vector& v) {
-        os << "[";
-        for (std::size_t i = 0; i < N; ++i) {
-            os << v.data_[i] << (i + 1 < N ? ", " : "");
-        }
-        os << "]";
-        return os;
-    }
-
-    template<typename U>
-    auto operator+(const U& scalar) const { return apply_scalar(scalar, std::plus<>{}); }
-    template<typename U>
-    auto operator-(const U& scalar) const { return apply_scalar(scalar, std::minus<>{}); }
-    template<typename U>
-    auto operator*(const U& scalar) const { return apply_scalar(scalar, std::multiplies<>{}); }
-    template<typename U>
-    auto operator/(const U& scalar) const { return apply_scalar(scalar, std::divides<>{}); }
-
-    template<typename U>
-    auto operator+(const Vector<U, N>& other) const { return apply_vector(other, std::plus<>{}); }
-    template<typename U>
-    auto operator-(const Vector<U, N>& other) const { return apply_vector(other, std::minus<>{}); }
-    template<typename U>
-    auto operator*(const Vector<U, N>& other) const { return apply_vector(other, std::multiplies<>{}); }
-    template<typename U>
-    auto operator/(const Vector<U, N>& other) const { return apply_vector(other, std::divides<>{}); }
-
-    template<std::size_t M>
-    auto resize() const {
-        Vector<T, M> result;
-        constexpr std::size_t minN = (N < M ? N : M);
-        for (std::size_t i = 0; i < minN; ++i)
-            result[i] = data_[i];
-        return result;
-    }
-
-    template<typename U>
-    auto convert() const {
-        Vector<U, N> result;
-        for (std::size_t i = 0; i < N; ++i)
-            result[i] = static_cast<U>(data_[i]);
-        return result;
-    }
-
-    template<int StartIdx, int EndIdx>
-    auto slice() const {
-        constexpr int s = (StartIdx < 0 ? static_cast<int>(N) + StartIdx : StartIdx);
-        constexpr int e = (EndIdx   < 0 ? static_cast<int>(N) + EndIdx   : EndIdx);
-        static_assert(s >= 0 && s < static_cast<int>(N), "slice start out of range");
-        static_assert(e >= 0 && e < static_cast<int>(N), "slice end out of range");
-        constexpr std::size_t len = (s <= e ? (e - s + 1) : (s - e + 1));
-        Vector<T, len> result;
-        if constexpr (s <= e) {
-            for (std::size_t i = 0; i < len; ++i)
-                result[i] = data_[s + i];
-        } else {
-            for (std::size_t i = 0; i < len; ++i)
-                result[i] = data_[s - i];
-        }
-        return result;
-    }
-
-private:
-    std::array<T, N> data_;
-
-    std::size_t normalize_index(int index) const {
-        int idx = (index < 0 ? static_cast<int>(N) + index : index);
-        if (idx < 0 || idx >= static_cast<int>(N)) {
-            std::ostringstream oss;
-            oss << "Index " << index << " out of range for Vector<" << N << ">";
-            throw std::out_of_range(oss.str());
-        }
-        return static_cast<std::size_t>(idx);
-    }
-
-    template<typename U, typename Op>
-    auto apply_scalar(const U& scalar, Op op) const {
-        using R = Promote<T, U>;
-        Vector<R, N> result;
-        for (std::size_t i = 0; i < N; ++i)
-            result[i] = op(data_[i], scalar);
-        return result;
-    }
-
-    template<typename U, typename Op>
-    auto apply_vector(const Vector<U, N>& other, Op op) const {
-        using R = Promote<T, U>;
-        Vector<R, N> result;
-        for (std::size_t i = 0; i < N; ++i)
-            result[i] = op(data_[i], other[i]);
-        return result;
-    }
-};
-
-template<typename T1, std::size_t N, typename U1, typename T2, typename U2>
-auto weighted_sum(const Vector<T1, N>& v1,
-                  const U1& alpha,
-                  const Vector<T2, N>& v2,
-                  const U2& beta) {
-    using R1 = std::common_type_t<T1, U1>;
-    using R2 = std::common_type_t<T2, U2>;
-    using R  = typename PromoteMultiple<R1, R2>::type;
-    Vector<R, N> result;
-    for (std::size_t i = 0; i < N; ++i)
-        result[i] = alpha * v1[i] + beta * v2[i];
-    return result;
-}
-
-template<typename T1, std::size_t N1, typename T2, std::size_t N2>
-auto concat(const Vector<T1, N1>& v1, const Vector<T2, N2>& v2) {
-    using R = typename PromoteMultiple<T1, T2>::type;
-    constexpr std::size_t M = N1 + N2;
-    Vector<R, M> result;
-    for (std::size_t i = 0; i < N1; ++i) result[i] = v1[i];
-    for (std::size_t j = 0; j < N2; ++j) result[N1 + j] = v2[j];
-    return result;
-}
-
-template<typename V, typename... Vs>
-auto concat(const V& first, const Vs&... rest) {
-    constexpr std::size_t total = (V::dimension + ... + Vs::dimension);
-    using R = typename PromoteMultiple<typename V::value_type, typename Vs::value_type...>::type;
-    Vector<R, total> result;
-    std::size_t pos = 0;
-    auto append = [&](const auto& vec) {
-        for (std::size_t i = 0; i < std::decay_t<decltype(vec)>::dimension; ++i)
-            result[pos++] = vec[i];
-    };
-    (append(first), ..., append(rest));
-    return result;
-}
-
-template<typename T, typename... Args>
-auto make_vector(Args&&... args) {
-    constexpr std::size_t N = sizeof...(Args);
-    Vector<T, N> result;
-    std::size_t i = 0;
-    ((result[i++] = static_cast<T>(args)), ...);
-    return result;
-}
-
-template<typename... Args>
-auto build_vector(Args&&... args) {
-    using U = std::common_type_t<Args...>;
-    constexpr std::size_t N = sizeof...(Args);
-    Vector<U, N> result;
-    std::size_t i = 0;
-    ((result[i++] = static_cast<U>(args)), ...);
-    return result;
-}
-
-constexpr std::size_t CLI_DIM = 3;
-using CliVector = Vector<double, CLI_DIM>;
-
-void printMenu() {
-    std::cout << "\n=== Меню операцій над векторами ===\n";
-    std::cout << "1. Ввести вектори\n";
-    std::cout << "2. Додати вектори\n";
-    std::cout << "3. Відняти вектори\n";
-    std::cout << "4. Множення вектора на скаляр\n";
-    std::cout << "5. Ділення вектора на скаляр\n";
-    std::cout << "6. Вивести поточні вектори\n";
-    std::cout << "0. Вийти\n";
-    std::cout << "Оберіть опцію: ";
-}
-
-void inputVector(CliVector &v, const std::string &name) {
-    std::cout << "Введіть " << name << " (" << CLI_DIM << " значень): ";
-    for (std::size_t i = 0; i < CLI_DIM; ++i) {
-        std::cin >> v[i];
-    }
-}
-
-int main() {
-    CliVector v1, v2;
-    bool hasInput = false;
-    int choice;
-    double scalar;
-
-    while (true) {
-        printMenu();
-        std::cin >> choice;
-        switch (choice) {
-            case 1:
-                inputVector(v1, "вектор 1");
-                inputVector(v2, "вектор 2");
-                hasInput = true;
-                break;
-            case 2:
-                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
-                std::cout << "v1 + v2 = " << (v1 + v2) << "\n";
-                break;
-            case 3:
-                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
-                std::cout << "v1 - v2 = " << (v1 - v2) << "\n";
-                break;
-            case 4:
-                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
-                std::cout << "Введіть скаляр: ";
-                std::cin >> scalar;
-                std::cout << "v1 * скаляр = " << (v1 * scalar) << "\n";
-                std::cout << "v2 * скаляр = " << (v2 * scalar) << "\n";
-                break;
-            case 5:
-                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
-                std::cout << "Введіть скаляр: ";
-                std::cin >> scalar;
-                try {
-                    std::cout << "v1 / скаляр = " << (v1 / scalar) << "\n";
-                    std::cout << "v2 / скаляр = " << (v2 / scalar) << "\n";
-                } catch (const std::exception &e) {
-                    std::cout << "Помилка: " << e.what() << "\n";
-                }
-                break;
-            case 6:
-                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
-                std::cout << "Вектор 1: " << v1 << "\n";
-                std::cout << "Вектор 2: " << v2 << "\n";
-                break;
-            case 0:
-                std::cout << "Вихід. До побачення!\n";
-                return 0;
-            default:
-                std::cout << "Неправильна опція, спробуйте ще раз.\n";
-        }
-    }
-
-    return 0;
-}
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "vector_all.hpp"
+
+constexpr std::size_t CLI_DIM = 3;
+using CliVector = Vector<double, CLI_DIM>;
+
+void printMenu() {
+    std::cout << "\n=== Меню операцій над векторами ===\n";
+    std::cout << "1. Ввести вектори\n";
+    std::cout << "2. Додати вектори\n";
+    std::cout << "3. Відняти вектори\n";
+    std::cout << "4. Множення вектора на скаляр\n";
+    std::cout << "5. Ділення вектора на скаляр\n";
+    std::cout << "6. Вивести поточні вектори\n";
+    std::cout << "0. Вийти\n";
+    std::cout << "Оберіть опцію: ";
+}
+
+void inputVector(CliVector &v, const std::string &name) {
+    std::cout << "Введіть " << name << " (" << CLI_DIM << " значень): ";
+    for (std::size_t i = 0; i < CLI_DIM; ++i) {
+        std::cin >> v[i];
+    }
+}
+
+// ---- Потоковий режим: по вектору (або парі векторів) на рядок, без меню ----
+
+enum class StreamOp { add, sub, scale, divide, weighted_sum, dot };
+
+struct StreamOptions {
+    StreamOp op = StreamOp::add;
+    std::size_t dim = CLI_DIM;
+    std::string in = "-";
+    std::string out = "-";
+    double scalar = 1.0;
+    double alpha = 1.0;
+    double beta = 1.0;
+};
+
+struct StreamStats {
+    std::size_t lines = 0;
+    std::size_t failed = 0;
+    std::size_t first_error_line = 0;
+};
+
+constexpr std::size_t STREAM_BLOCK_BYTES = 1 << 20;
+constexpr std::size_t STREAM_QUEUE_BLOCKS = 4;
+
+void printStreamUsage(std::ostream &os) {
+    os << "Використання: code_oop --op add|sub|scale|divide|weighted_sum|dot [--dim N]\n"
+          "                       [--in файл] [--out файл] [--scalar s] [--alpha a] [--beta b]\n"
+          "Без аргументів запускається інтерактивне меню.\n"
+          "add, sub, weighted_sum, dot: у рядку два вектори (\"1 2 3 4 5 6\" або \"[1, 2, 3] [4, 5, 6]\").\n"
+          "scale, divide: у рядку один вектор. --in/--out за замовчуванням - stdin/stdout.\n"
+          "Підтримувані розмірності: 2, 3, 4, 8, 16.\n";
+}
+
+bool parseStreamOp(std::string_view name, StreamOp &op) {
+    static constexpr std::pair<std::string_view, StreamOp> ops[] = {
+        {"add", StreamOp::add}, {"sub", StreamOp::sub}, {"scale", StreamOp::scale},
+        {"divide", StreamOp::divide}, {"weighted_sum", StreamOp::weighted_sum}, {"dot", StreamOp::dot},
+    };
+    for (const auto &[n, o] : ops) {
+        if (n == name) { op = o; return true; }
+    }
+    return false;
+}
+
+template<typename T>
+bool parseStreamNumber(std::string_view text, T &value) {
+    const char *last = text.data() + text.size();
+    const auto [ptr, ec] = detail::parse_scalar(text.data(), last, value);
+    return ec == std::errc{} && ptr == last;
+}
+
+bool parseStreamOptions(int argc, char **argv, StreamOptions &o, std::string &error) {
+    bool hasOp = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) { error = "немає значення для " + std::string(arg); return false; }
+        const std::string_view value = argv[++i];
+        bool ok = true;
+        if (arg == "--op") ok = hasOp = parseStreamOp(value, o.op);
+        else if (arg == "--dim") ok = parseStreamNumber(value, o.dim);
+        else if (arg == "--in") o.in = value;
+        else if (arg == "--out") o.out = value;
+        else if (arg == "--scalar") ok = parseStreamNumber(value, o.scalar);
+        else if (arg == "--alpha") ok = parseStreamNumber(value, o.alpha);
+        else if (arg == "--beta") ok = parseStreamNumber(value, o.beta);
+        else { error = "невідомий аргумент " + std::string(arg); return false; }
+        if (!ok) { error = "неправильне значення " + std::string(value) + " для " + std::string(arg); return false; }
+    }
+    if (!hasOp) { error = "не задано --op"; return false; }
+    if (o.op == StreamOp::divide && o.scalar == 0.0) { error = "ділення на нуль (--scalar 0)"; return false; }
+    return true;
+}
+
+// Розбирає один рядок і дописує результат в out; false - рядок хибний
+template<std::size_t N>
+bool processStreamLine(const StreamOptions &o, const char *p, const char *last, std::string &out) {
+    using V = Vector<double, N>;
+    const auto a = detail::parse_vector_prefix<double, N>(p, last);
+    if (!a) return false;
+    p = a.ptr;
+    V b;
+    const bool binary = o.op != StreamOp::scale && o.op != StreamOp::divide;
+    if (binary) {
+        const auto r = detail::parse_vector_prefix<double, N>(detail::skip_text_separator(p, last), last);
+        if (!r) return false;
+        b = r.value;
+        p = r.ptr;
+    }
+    if (detail::skip_text_space(p, last) != last) return false;
+
+    switch (o.op) {
+        case StreamOp::add: format_vector(out, a.value + b); break;
+        case StreamOp::sub: format_vector(out, a.value - b); break;
+        case StreamOp::scale: format_vector(out, a.value * o.scalar); break;
+        case StreamOp::divide: format_vector(out, a.value / o.scalar); break;
+        case StreamOp::weighted_sum: format_vector(out, weighted_sum(a.value, o.alpha, b, o.beta)); break;
+        case StreamOp::dot: {
+            char buf[32];
+            const auto r = std::to_chars(buf, buf + sizeof buf, dot(a.value, b));
+            out.append(buf, r.ptr);
+            break;
+        }
+    }
+    out += '\n';
+    return true;
+}
+
+template<std::size_t N>
+void processStreamBlock(const StreamOptions &o, const std::string &block, std::string &out, StreamStats &stats) {
+    std::string_view text = block;
+    while (!text.empty()) {
+        const std::size_t eol = text.find('\n');
+        const std::string_view line = text.substr(0, eol);
+        ++stats.lines;
+        const char *last = line.data() + line.size();
+        const char *p = detail::skip_text_space(line.data(), last);
+        if (p != last && *p != '#' && !processStreamLine<N>(o, p, last, out)) {
+            if (stats.failed++ == 0) stats.first_error_line = stats.lines;
+        }
+        if (eol == std::string_view::npos) break;
+        text.remove_prefix(eol + 1);
+    }
+}
+
+// Три стадії: читання блоками повних рядків, розбір і обчислення, запис.
+// Стадії з'єднані обмеженими чергами, тому працюють одночасно.
+template<std::size_t N>
+int runStream(const StreamOptions &o, std::istream &in, std::ostream &os) {
+    BoundedQueue<std::string> parsed(STREAM_QUEUE_BLOCKS), formatted(STREAM_QUEUE_BLOCKS);
+
+    std::thread reader([&] {
+        std::string carry;
+        while (in) {
+            std::string block = std::move(carry);
+            const std::size_t old = block.size();
+            block.resize(old + STREAM_BLOCK_BYTES);
+            in.read(block.data() + old, static_cast<std::streamsize>(STREAM_BLOCK_BYTES));
+            block.resize(old + static_cast<std::size_t>(in.gcount()));
+            const std::size_t eol = block.rfind('\n');
+            if (eol == std::string::npos) { carry = std::move(block); continue; }
+            carry.assign(block, eol + 1, std::string::npos);
+            block.resize(eol + 1); // з '\n' в кінці: інакше порожній рядок на межі блоку пропадає з нумерації
+            if (!parsed.push(std::move(block))) return;
+        }
+        if (!carry.empty()) parsed.push(std::move(carry));
+        parsed.close();
+    });
+
+    bool writeOk = true;
+    std::thread writer([&] {
+        std::string block;
+        while (formatted.pop(block)) {
+            if (writeOk && !os.write(block.data(), static_cast<std::streamsize>(block.size()))) writeOk = false;
+        }
+        os.flush();
+        if (!os) writeOk = false;
+    });
+
+    StreamStats stats;
+    std::string block;
+    while (parsed.pop(block)) {
+        std::string out;
+        out.reserve(block.size() + block.size() / 2);
+        processStreamBlock<N>(o, block, out, stats);
+        formatted.push(std::move(out));
+    }
+    formatted.close();
+    reader.join();
+    writer.join();
+
+    if (!writeOk) { std::cerr << "Помилка запису у " << o.out << "\n"; return 1; }
+    if (stats.failed > 0) {
+        std::cerr << "Рядків з помилками: " << stats.failed << " (перший: рядок " << stats.first_error_line << ")\n";
+        return 2;
+    }
+    return 0;
+}
+
+int streamMain(int argc, char **argv) {
+    StreamOptions o;
+    std::string error;
+    if (argc == 2 && (std::string_view(argv[1]) == "--help" || std::string_view(argv[1]) == "-h")) {
+        printStreamUsage(std::cout);
+        return 0;
+    }
+    if (!parseStreamOptions(argc, argv, o, error)) {
+        std::cerr << "Помилка: " << error << "\n";
+        printStreamUsage(std::cerr);
+        return 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+    std::ifstream inFile;
+    std::ofstream outFile;
+    if (o.in != "-") {
+        inFile.open(o.in, std::ios::binary);
+        if (!inFile) { std::cerr << "Не вдалося відкрити " << o.in << "\n"; return 1; }
+    }
+    if (o.out != "-") {
+        outFile.open(o.out, std::ios::binary | std::ios::trunc);
+        if (!outFile) { std::cerr << "Не вдалося відкрити " << o.out << "\n"; return 1; }
+    }
+    std::istream &in = o.in != "-" ? static_cast<std::istream &>(inFile) : std::cin;
+    std::ostream &os = o.out != "-" ? static_cast<std::ostream &>(outFile) : std::cout;
+
+    switch (o.dim) {
+        case 2: return runStream<2>(o, in, os);
+        case 3: return runStream<3>(o, in, os);
+        case 4: return runStream<4>(o, in, os);
+        case 8: return runStream<8>(o, in, os);
+        case 16: return runStream<16>(o, in, os);
+        default:
+            std::cerr << "Помилка: розмірність " << o.dim << " не підтримується\n";
+            printStreamUsage(std::cerr);
+            return 1;
+    }
+}
+
+// ---- Вимірювання продуктивності: --bench [--filter підрядок] [--json файл] [--baseline файл] [--isa набір|all] ----
+
+struct BenchResult {
+    std::string name;
+    std::size_t iterations = 0;
+    double nsPerOp = 0;
+    double bytesPerSecond = 0;
+    double itemsPerSecond = 0;
+};
+
+struct BenchCase {
+    std::string name;
+    double bytesPerOp;
+    double itemsPerOp;
+    std::function<void(std::size_t)> run;   // виконує задану кількість ітерацій
+};
+
+struct BenchOptions {
+    std::string filter;
+    std::string json;
+    std::string baseline;
+    std::string isa;                         // порожньо - набір, вибраний диспетчеризацією
+    double minTime = 0.1;
+    double threshold = 1.10;
+};
+
+// Не дає компілятору викинути обчислення або винести читання з циклу
+template<typename T>
+inline void benchKeep(T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+template<typename T> constexpr const char *benchTypeName();
+template<> constexpr const char *benchTypeName<int>() { return "int"; }
+template<> constexpr const char *benchTypeName<float>() { return "float"; }
+template<> constexpr const char *benchTypeName<double>() { return "double"; }
+
+// Кількість ітерацій подвоюється, доки замір не триватиме щонайменше minTime секунд
+BenchResult runBench(const BenchCase &c, double minTime) {
+    using clock = std::chrono::steady_clock;
+    std::size_t iterations = 1;
+    while (true) {
+        const auto start = clock::now();
+        c.run(iterations);
+        const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        if (seconds >= minTime || iterations >= (std::size_t(1) << 40)) {
+            BenchResult r;
+            r.name = c.name;
+            r.iterations = iterations;
+            r.nsPerOp = seconds * 1e9 / static_cast<double>(iterations);
+            r.bytesPerSecond = c.bytesPerOp * static_cast<double>(iterations) / seconds;
+            r.itemsPerSecond = c.itemsPerOp * static_cast<double>(iterations) / seconds;
+            return r;
+        }
+        const double grow = seconds > 0 ? minTime * 1.4 / seconds : 10.0;
+        iterations = static_cast<std::size_t>(static_cast<double>(iterations) * std::clamp(grow, 2.0, 10.0));
+    }
+}
+
+template<typename T, std::size_t N>
+Vector<T, N> benchInput(int seed) {
+    Vector<T, N> v;
+    for (std::size_t i = 0; i < N; ++i)
+        v.at_unchecked(i) = static_cast<T>(1 + (i * 7 + static_cast<std::size_t>(seed)) % 13);
+    return v;
+}
+
+template<typename T, std::size_t N, std::size_t... I>
+Vector<T, N> benchMakeVector(const Vector<T, N> &src, std::index_sequence<I...>) {
+    return make_vector<T>(src.template get<I>()...);
+}
+
+template<typename T, std::size_t N, std::size_t... I>
+Vector<T, N> benchBuildVector(const Vector<T, N> &src, std::index_sequence<I...>) {
+    return build_vector(src.template get<I>()...);
+}
+
+template<typename T, std::size_t N>
+void addBenchCases(std::vector<BenchCase> &cases) {
+    using U = std::conditional_t<std::is_same_v<T, double>, float, double>;
+    const std::string suffix = std::string("<") + benchTypeName<T>() + ", " + std::to_string(N) + ">";
+    const double e = static_cast<double>(N), s = static_cast<double>(sizeof(T));
+
+    // Вхідні дані спільні для всіх замірів цього T, N і живуть до кінця програми
+    auto a = std::make_shared<Vector<T, N>>(benchInput<T, N>(1));
+    auto b = std::make_shared<Vector<T, N>>(benchInput<T, N>(2));
+
+    auto add = [&cases, &suffix](std::string name, double bytes, double items, std::function<void(std::size_t)> run) {
+        cases.push_back({name + suffix, bytes, items, std::move(run)});
+    };
+
+    add("add", 3 * e * s, e, [a, b](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { Vector<T, N> r = *a + *b; benchKeep(r); benchKeep(*a); }
+    });
+    add("sub", 3 * e * s, e, [a, b](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { Vector<T, N> r = *a - *b; benchKeep(r); benchKeep(*a); }
+    });
+    add("mul_scalar", 2 * e * s, e, [a](std::size_t n) {
+        T scalar = T(3);
+        for (std::size_t k = 0; k < n; ++k) { Vector<T, N> r = *a * scalar; benchKeep(r); benchKeep(scalar); }
+    });
+    add("div_scalar", 2 * e * s, e, [a](std::size_t n) {
+        T scalar = T(3);
+        for (std::size_t k = 0; k < n; ++k) { Vector<T, N> r = *a / scalar; benchKeep(r); benchKeep(scalar); }
+    });
+    add("div_scalar_reciprocal", 2 * e * s, e, [a](std::size_t n) {
+        T scalar = T(3);
+        for (std::size_t k = 0; k < n; ++k) { auto r = divide(*a, scalar, ReciprocalMath{}); benchKeep(r); benchKeep(scalar); }
+    });
+    add("div", 3 * e * s, e, [a, b](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { Vector<T, N> r = *a / *b; benchKeep(r); benchKeep(*a); }
+    });
+    add("div_approx1", 3 * e * s, e, [a, b](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = divide(*a, *b, ApproxMath<1>{}); benchKeep(r); benchKeep(*a); }
+    });
+    add("normalize_approx1", e * s + e * sizeof(detail::norm_result_t<T>), e, [a](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = normalize(*a, ApproxMath<1>{}); benchKeep(r); benchKeep(*a); }
+    });
+    add("weighted_sum", 3 * e * s, e, [a, b](std::size_t n) {
+        T alpha = T(2), beta = T(3);
+        for (std::size_t k = 0; k < n; ++k) { auto r = weighted_sum(*a, alpha, *b, beta); benchKeep(r); benchKeep(alpha); }
+    });
+    add("linear_combination6", 7 * e * s, e, [a, b](std::size_t n) {
+        T k1 = T(2), k2 = T(3);
+        for (std::size_t k = 0; k < n; ++k) {
+            auto r = linear_combination(*a, k1, *b, k2, *a, k1, *b, k2, *a, k1, *b, k2);
+            benchKeep(r); benchKeep(k1);
+        }
+    });
+    add("concat2", 4 * e * s, 2 * e, [a, b](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = concat(*a, *b); benchKeep(r); benchKeep(*a); }
+    });
+    add("concat3", 6 * e * s, 3 * e, [a, b](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = concat(*a, *b, *a); benchKeep(r); benchKeep(*a); }
+    });
+    add("slice", e * s, e / 2, [a](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = a->template slice<0, N / 2>(); benchKeep(r); benchKeep(*a); }
+    });
+    add("resize", 3 * e * s, 2 * e, [a](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = a->template resize<2 * N>(); benchKeep(r); benchKeep(*a); }
+    });
+    add("convert", e * (s + sizeof(U)), e, [a](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = a->template convert<U>(); benchKeep(r); benchKeep(*a); }
+    });
+    // make_vector і build_vector розгортають N аргументів, тому лише для малих N
+    if constexpr (N <= 16) {
+        add("make_vector", 2 * e * s, e, [a](std::size_t n) {
+            for (std::size_t k = 0; k < n; ++k) {
+                auto r = benchMakeVector(*a, std::make_index_sequence<N>{}); benchKeep(r); benchKeep(*a);
+            }
+        });
+        add("build_vector", 2 * e * s, e, [a](std::size_t n) {
+            for (std::size_t k = 0; k < n; ++k) {
+                auto r = benchBuildVector(*a, std::make_index_sequence<N>{}); benchKeep(r); benchKeep(*a);
+            }
+        });
+    }
+
+    // Текст: байти - це символи рядка
+    auto text = std::make_shared<std::string>();
+    format_vector(*text, *a);
+    const double chars = static_cast<double>(text->size());
+    add("format_vector", chars, e, [a](std::size_t n) {
+        std::string out;
+        out.reserve(N * 34 + 2);
+        for (std::size_t k = 0; k < n; ++k) { out.clear(); format_vector(out, *a); benchKeep(out); benchKeep(*a); }
+    });
+    add("parse_vector", chars, e, [text](std::size_t n) {
+        for (std::size_t k = 0; k < n; ++k) { auto r = parse_vector<T, N>(*text); benchKeep(r); benchKeep(*text); }
+    });
+    add("ostream_output", chars, e, [a](std::size_t n) {
+        std::ostringstream os;
+        for (std::size_t k = 0; k < n; ++k) { os.str(std::string()); os << *a; benchKeep(os); }
+    });
+}
+
+template<typename T, std::size_t... Ns>
+void addBenchDims(std::vector<BenchCase> &cases) {
+    (addBenchCases<T, Ns>(cases), ...);
+}
+
+// Ядра диспетчеризації напряму з таблиці набору isa: ім'я закінчується "/isa",
+// тож заміри різних наборів порівнюються між собою і з базовою лінією окремо
+template<typename T>
+void addKernelCases(std::vector<BenchCase> &cases, dispatch::Isa isa) {
+    using C = typename dispatch::Kernels<T>::convert_type;
+    constexpr std::size_t n = 4096;
+    const dispatch::Kernels<T> *k = dispatch::kernels_for<T>(isa);
+    const std::string suffix = std::string("<") + benchTypeName<T>() + ", " + std::to_string(n) + ">/" +
+                               dispatch::isa_name(isa);
+    const double e = static_cast<double>(n), s = static_cast<double>(sizeof(T));
+
+    auto a = std::make_shared<std::vector<T>>(n), b = std::make_shared<std::vector<T>>(n);
+    auto out = std::make_shared<std::vector<T>>(n);
+    auto converted = std::make_shared<std::vector<C>>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        (*a)[i] = static_cast<T>(1 + (i * 7 + 1) % 13);
+        (*b)[i] = static_cast<T>(1 + (i * 7 + 2) % 13);
+    }
+
+    auto add = [&cases, &suffix](std::string name, double bytes, double items, std::function<void(std::size_t)> run) {
+        cases.push_back({"kernel_" + name + suffix, bytes, items, std::move(run)});
+    };
+
+    add("add", 3 * e * s, e, [k, a, b, out](std::size_t iters) {
+        for (std::size_t j = 0; j < iters; ++j) { k->add(a->data(), b->data(), out->data(), n); benchKeep(*out); }
+    });
+    add("mul_scalar", 2 * e * s, e, [k, a, out](std::size_t iters) {
+        T scalar = static_cast<T>(0.5);
+        for (std::size_t j = 0; j < iters; ++j) { k->mul_scalar(a->data(), scalar, out->data(), n); benchKeep(*out); benchKeep(scalar); }
+    });
+    add("div", 3 * e * s, e, [k, a, b, out](std::size_t iters) {
+        for (std::size_t j = 0; j < iters; ++j) { k->div(a->data(), b->data(), out->data(), n); benchKeep(*out); }
+    });
+    add("axpby", 3 * e * s, e, [k, a, b, out](std::size_t iters) {
+        T alpha = static_cast<T>(2), beta = static_cast<T>(-0.5);
+        for (std::size_t j = 0; j < iters; ++j) { k->axpby(alpha, a->data(), beta, b->data(), out->data(), n); benchKeep(*out); benchKeep(alpha); }
+    });
+    add("sum", e * s, e, [k, a](std::size_t iters) {
+        for (std::size_t j = 0; j < iters; ++j) { T r = k->sum(a->data(), n); benchKeep(r); benchKeep(*a); }
+    });
+    add("dot", 2 * e * s, e, [k, a, b](std::size_t iters) {
+        for (std::size_t j = 0; j < iters; ++j) { T r = k->dot(a->data(), b->data(), n); benchKeep(r); benchKeep(*a); }
+    });
+    add("max", e * s, e, [k, a](std::size_t iters) {
+        for (std::size_t j = 0; j < iters; ++j) { T r = k->max(a->data(), n); benchKeep(r); benchKeep(*a); }
+    });
+    add(std::string("convert_") + benchTypeName<C>(), e * (s + sizeof(C)), e, [k, a, converted](std::size_t iters) {
+        for (std::size_t j = 0; j < iters; ++j) { k->convert(a->data(), converted->data(), n); benchKeep(*converted); }
+    });
+}
+
+std::vector<BenchCase> makeBenchCases(const std::vector<dispatch::Isa> &isas) {
+    std::vector<BenchCase> cases;
+    addBenchDims<int, 3, 4, 16, 256, 4096>(cases);
+    addBenchDims<float, 3, 4, 16, 256, 4096>(cases);
+    addBenchDims<double, 3, 4, 16, 256, 4096>(cases);
+    for (const dispatch::Isa isa : isas) {
+        addKernelCases<float>(cases, isa);
+        addKernelCases<double>(cases, isa);
+    }
+    return cases;
+}
+
+// Формат JSON сумісний за полями з Google Benchmark; кожен замір - окремий рядок,
+// тому файл базової лінії читається без повного розбору JSON
+void writeBenchJson(std::ostream &os, const std::vector<BenchResult> &results) {
+    os << "{\n  \"context\": {\"library\": \"Vector\", \"simd\": \"" << simd::isa_name
+       << "\", \"dispatch\": \"" << dispatch::isa_name(dispatch::active_isa()) << "\"},\n"
+       << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r = results[i];
+        os << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+           << ", \"real_time\": " << r.nsPerOp << ", \"time_unit\": \"ns\""
+           << ", \"bytes_per_second\": " << r.bytesPerSecond
+           << ", \"items_per_second\": " << r.itemsPerSecond << "}"
+           << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    os << "  ]\n}\n";
+}
+
+bool readBenchBaseline(const std::string &path, std::vector<std::pair<std::string, double>> &baseline) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    const std::string nameKey = "\"name\": \"", timeKey = "\"real_time\": ";
+    while (std::getline(in, line)) {
+        const std::size_t n = line.find(nameKey), t = line.find(timeKey);
+        if (n == std::string::npos || t == std::string::npos) continue;
+        const std::size_t nameStart = n + nameKey.size();
+        const std::size_t nameEnd = line.find('"', nameStart);
+        double time = 0;
+        const char *first = line.data() + t + timeKey.size();
+        if (std::from_chars(first, line.data() + line.size(), time).ec != std::errc{}) continue;
+        baseline.emplace_back(line.substr(nameStart, nameEnd - nameStart), time);
+    }
+    return true;
+}
+
+// Вирівнювання за кількістю символів UTF-8, а не байтів
+std::string benchPad(std::string_view text, std::size_t width, bool left = false) {
+    std::size_t chars = 0;
+    for (const char ch : text)
+        chars += (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+    const std::string fill(chars < width ? width - chars : 0, ' ');
+    return left ? std::string(text) + fill : fill + std::string(text);
+}
+
+int benchMain(int argc, char **argv) {
+    BenchOptions o;
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) { std::cerr << "Помилка: немає значення для " << arg << "\n"; return 1; }
+        const std::string_view value = argv[++i];
+        bool ok = true;
+        if (arg == "--filter") o.filter = value;
+        else if (arg == "--json") o.json = value;
+        else if (arg == "--baseline") o.baseline = value;
+        else if (arg == "--isa") o.isa = value;
+        else if (arg == "--min-time") ok = parseStreamNumber(value, o.minTime);
+        else if (arg == "--threshold") ok = parseStreamNumber(value, o.threshold);
+        else { std::cerr << "Помилка: невідомий аргумент " << arg << "\n"; return 1; }
+        if (!ok) { std::cerr << "Помилка: неправильне значення " << value << " для " << arg << "\n"; return 1; }
+    }
+
+    std::vector<std::pair<std::string, double>> baseline;
+    if (!o.baseline.empty() && !readBenchBaseline(o.baseline, baseline)) {
+        std::cerr << "Не вдалося відкрити " << o.baseline << "\n";
+        return 1;
+    }
+
+    // Заміри ядер: активний набір, один заданий або всі, які підтримує процесор
+    std::vector<dispatch::Isa> isas{dispatch::active_isa()};
+    if (o.isa == "all") {
+        isas = dispatch::supported_isas();
+    } else if (!o.isa.empty()) {
+        dispatch::Isa isa;
+        if (!dispatch::parse_isa(o.isa, isa) || !dispatch::set_isa(isa)) {
+            std::cerr << "Помилка: набір інструкцій " << o.isa << " не підтримується\n";
+            return 1;
+        }
+        isas = {isa};
+    }
+
+    std::cout << "SIMD: " << simd::isa_name << ", диспетчеризація: " << dispatch::isa_name(dispatch::active_isa())
+              << " (доступні:";
+    for (const dispatch::Isa isa : dispatch::supported_isas())
+        std::cout << " " << dispatch::isa_name(isa);
+    std::cout << ")\n";
+    std::cout << benchPad("Бенчмарк", 42, true) << benchPad("нс/оп", 13) << benchPad("байт/с", 15)
+              << benchPad("елем/с", 15) << benchPad("ітерацій", 13) << "\n" << std::flush;
+    std::vector<BenchResult> results;
+    std::size_t regressions = 0;
+    for (const BenchCase &c : makeBenchCases(isas)) {
+        if (!o.filter.empty() && c.name.find(o.filter) == std::string::npos) continue;
+        const BenchResult r = runBench(c, o.minTime);
+        std::printf("%-42s %12.2f %14.4g %14.4g %12zu", r.name.c_str(), r.nsPerOp, r.bytesPerSecond,
+                    r.itemsPerSecond, r.iterations);
+        for (const auto &[name, time] : baseline) {
+            if (name != r.name) continue;
+            const double ratio = r.nsPerOp / time;
+            std::printf("  x%.2f%s", ratio, ratio > o.threshold ? " ПОВІЛЬНІШЕ" : "");
+            if (ratio > o.threshold) ++regressions;
+        }
+        std::printf("\n");
+        results.push_back(r);
+    }
+
+    if (!o.json.empty()) {
+        std::ofstream out(o.json, std::ios::trunc);
+        writeBenchJson(out, results);
+        if (!out) { std::cerr << "Помилка запису у " << o.json << "\n"; return 1; }
+    }
+    if (regressions > 0) {
+        std::cerr << "Повільніше за базову лінію: " << regressions << "\n";
+        return 3;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "--bench")
+        return benchMain(argc, argv);
+    if (argc > 1)
+        return streamMain(argc, argv);
+
+    CliVector v1, v2;
+    bool hasInput = false;
+    int choice;
+    double scalar;
+
+    while (true) {
+        printMenu();
+        std::cin >> choice;
+        switch (choice) {
+            case 1:
+                inputVector(v1, "вектор 1");
+                inputVector(v2, "вектор 2");
+                hasInput = true;
+                break;
+            case 2:
+                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
+                std::cout << "v1 + v2 = " << (v1 + v2) << "\n";
+                break;
+            case 3:
+                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
+                std::cout << "v1 - v2 = " << (v1 - v2) << "\n";
+                break;
+            case 4:
+                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
+                std::cout << "Введіть скаляр: ";
+                std::cin >> scalar;
+                std::cout << "v1 * скаляр = " << (v1 * scalar) << "\n";
+                std::cout << "v2 * скаляр = " << (v2 * scalar) << "\n";
+                break;
+            case 5:
+                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
+                std::cout << "Введіть скаляр: ";
+                std::cin >> scalar;
+#if VECTOR_HAS_EXCEPTIONS
+                try {
+                    std::cout << "v1 / скаляр = " << (v1 / scalar) << "\n";
+                    std::cout << "v2 / скаляр = " << (v2 / scalar) << "\n";
+                } catch (const std::exception &e) {
+                    std::cout << "Помилка: " << e.what() << "\n";
+                }
+#else
+                std::cout << "v1 / скаляр = " << (v1 / scalar) << "\n";
+                std::cout << "v2 / скаляр = " << (v2 / scalar) << "\n";
+#endif
+                break;
+            case 6:
+                if (!hasInput) { std::cout << "Будь ласка, спочатку введіть вектори!\n"; break; }
+                std::cout << "Вектор 1: " << v1 << "\n";
+                std::cout << "Вектор 2: " << v2 << "\n";
+                break;
+            case 0:
+                std::cout << "Вихід. До побачення!\n";
+                return 0;
+            default:
+                std::cout << "Неправильна опція, спробуйте ще раз.\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,2884 @@
+// Ядро бібліотеки: Vector, шаблони виразів, VectorView, згортки, SIMD і політика помилок
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__has_include)
+#  if __has_include(<version>)
+#    include <version>
+#  endif
+#endif
+#if defined(__cpp_lib_expected)
+#  include <expected>
+#endif
+
+// Допоміжна структура для двочкового просування типів
+template<typename A, typename B>
+using Promote = decltype(std::declval<A>() + std::declval<B>());
+
+template<typename... Ts>
+struct PromoteMultiple;
+
+template<typename T>
+struct PromoteMultiple<T> {
+    using type = T;
+};
+
+template<typename A, typename B, typename... Rest>
+struct PromoteMultiple<A, B, Rest...> {
+    using type = typename PromoteMultiple<
+        std::common_type_t<A, B>, Rest...
+    >::type;
+};
+
+// ---- SIMD: вибір набору інструкцій під час компіляції ----
+// VECTOR_DISABLE_SIMD примусово вмикає скалярний резервний шлях.
+
+#if !defined(VECTOR_DISABLE_SIMD)
+#  if defined(__AVX512F__)
+#    define VECTOR_SIMD_AVX512 1
+#  elif defined(__AVX2__)
+#    define VECTOR_SIMD_AVX2 1
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define VECTOR_SIMD_SSE2 1
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define VECTOR_SIMD_NEON 1
+#  endif
+#endif
+
+#if defined(VECTOR_SIMD_AVX512) || defined(VECTOR_SIMD_AVX2) || defined(VECTOR_SIMD_SSE2)
+#  include <immintrin.h>
+#elif defined(VECTOR_SIMD_NEON)
+#  include <arm_neon.h>
+#endif
+
+namespace simd {
+
+// Загальний випадок: тип без векторної реалізації, працює скалярний цикл.
+// Спеціалізації з has_mul мають fma(a, b, c) = a * b + c: одна інструкція там,
+// де є апаратна FMA (AVX-512F, -mfma, AArch64), інакше множення і додавання.
+template<typename T>
+struct Packet {
+    static constexpr bool enabled = false;
+    static constexpr bool has_mul = false;
+    static constexpr bool has_div = false;
+    static constexpr bool has_minmax = false;
+    static constexpr std::size_t width = 1;
+};
+
+#if defined(VECTOR_SIMD_AVX512)
+
+inline constexpr const char* isa_name = "avx512";
+
+// min/max - maskz-форми з повною маскою: безмасковий варіант GCC 12 будує на _mm512_undefined_*
+template<>
+struct Packet<float> {
+    using type = __m512;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 16;
+    static type load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, type v) { _mm512_storeu_ps(p, v); }
+    static type broadcast(float s) { return _mm512_set1_ps(s); }
+    static type add(type a, type b) { return _mm512_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+    static type min(type a, type b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+    static type max(type a, type b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+    static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+    static type fma(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+    static type div(type a, type b) { return _mm512_div_ps(a, b); }
+};
+
+template<>
+struct Packet<double> {
+    using type = __m512d;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 8;
+    static type load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, type v) { _mm512_storeu_pd(p, v); }
+    static type broadcast(double s) { return _mm512_set1_pd(s); }
+    static type add(type a, type b) { return _mm512_add_pd(a, b); }
+    static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+    static type min(type a, type b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+    static type max(type a, type b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+    static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+    static type fma(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+    static type div(type a, type b) { return _mm512_div_pd(a, b); }
+};
+
+template<>
+struct Packet<std::int32_t> {
+    using type = __m512i;
+    static constexpr bool enabled = true, has_mul = true, has_div = false;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 16;
+    static type load(const std::int32_t* p) { return _mm512_loadu_si512(p); }
+    static void store(std::int32_t* p, type v) { _mm512_storeu_si512(p, v); }
+    static type broadcast(std::int32_t s) { return _mm512_set1_epi32(s); }
+    static type add(type a, type b) { return _mm512_add_epi32(a, b); }
+    static type sub(type a, type b) { return _mm512_sub_epi32(a, b); }
+    static type min(type a, type b) { return _mm512_maskz_min_epi32(0xFFFF, a, b); }
+    static type max(type a, type b) { return _mm512_maskz_max_epi32(0xFFFF, a, b); }
+    static type mul(type a, type b) { return _mm512_mullo_epi32(a, b); }
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+};
+
+#elif defined(VECTOR_SIMD_AVX2)
+
+inline constexpr const char* isa_name = "avx2";
+
+template<>
+struct Packet<float> {
+    using type = __m256;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 8;
+    static type load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+    static type broadcast(float s) { return _mm256_set1_ps(s); }
+    static type add(type a, type b) { return _mm256_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+    static type min(type a, type b) { return _mm256_min_ps(a, b); }
+    static type max(type a, type b) { return _mm256_max_ps(a, b); }
+    static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+#  if defined(__FMA__)
+    static type fma(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+#  else
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+#  endif
+    static type div(type a, type b) { return _mm256_div_ps(a, b); }
+};
+
+template<>
+struct Packet<double> {
+    using type = __m256d;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 4;
+    static type load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, type v) { _mm256_storeu_pd(p, v); }
+    static type broadcast(double s) { return _mm256_set1_pd(s); }
+    static type add(type a, type b) { return _mm256_add_pd(a, b); }
+    static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+    static type min(type a, type b) { return _mm256_min_pd(a, b); }
+    static type max(type a, type b) { return _mm256_max_pd(a, b); }
+    static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+#  if defined(__FMA__)
+    static type fma(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+#  else
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+#  endif
+    static type div(type a, type b) { return _mm256_div_pd(a, b); }
+};
+
+template<>
+struct Packet<std::int32_t> {
+    using type = __m256i;
+    static constexpr bool enabled = true, has_mul = true, has_div = false;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 8;
+    static type load(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(std::int32_t* p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static type broadcast(std::int32_t s) { return _mm256_set1_epi32(s); }
+    static type add(type a, type b) { return _mm256_add_epi32(a, b); }
+    static type sub(type a, type b) { return _mm256_sub_epi32(a, b); }
+    static type min(type a, type b) { return _mm256_min_epi32(a, b); }
+    static type max(type a, type b) { return _mm256_max_epi32(a, b); }
+    static type mul(type a, type b) { return _mm256_mullo_epi32(a, b); }
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+};
+
+#elif defined(VECTOR_SIMD_SSE2)
+
+inline constexpr const char* isa_name = "sse2";
+
+template<>
+struct Packet<float> {
+    using type = __m128;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 4;
+    static type load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, type v) { _mm_storeu_ps(p, v); }
+    static type broadcast(float s) { return _mm_set1_ps(s); }
+    static type add(type a, type b) { return _mm_add_ps(a, b); }
+    static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+    static type min(type a, type b) { return _mm_min_ps(a, b); }
+    static type max(type a, type b) { return _mm_max_ps(a, b); }
+    static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+#  if defined(__FMA__)
+    static type fma(type a, type b, type c) { return _mm_fmadd_ps(a, b, c); }
+#  else
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+#  endif
+    static type div(type a, type b) { return _mm_div_ps(a, b); }
+};
+
+template<>
+struct Packet<double> {
+    using type = __m128d;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 2;
+    static type load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, type v) { _mm_storeu_pd(p, v); }
+    static type broadcast(double s) { return _mm_set1_pd(s); }
+    static type add(type a, type b) { return _mm_add_pd(a, b); }
+    static type sub(type a, type b) { return _mm_sub_pd(a, b); }
+    static type min(type a, type b) { return _mm_min_pd(a, b); }
+    static type max(type a, type b) { return _mm_max_pd(a, b); }
+    static type mul(type a, type b) { return _mm_mul_pd(a, b); }
+#  if defined(__FMA__)
+    static type fma(type a, type b, type c) { return _mm_fmadd_pd(a, b, c); }
+#  else
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+#  endif
+    static type div(type a, type b) { return _mm_div_pd(a, b); }
+};
+
+template<>
+struct Packet<std::int32_t> {
+    using type = __m128i;
+#  if defined(__SSE4_1__)
+    static constexpr bool enabled = true, has_mul = true, has_div = false;
+#  else
+    static constexpr bool enabled = true, has_mul = false, has_div = false;
+#  endif
+    static constexpr bool has_minmax = has_mul;
+    static constexpr std::size_t width = 4;
+    static type load(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(std::int32_t* p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static type broadcast(std::int32_t s) { return _mm_set1_epi32(s); }
+    static type add(type a, type b) { return _mm_add_epi32(a, b); }
+    static type sub(type a, type b) { return _mm_sub_epi32(a, b); }
+#  if defined(__SSE4_1__)
+    static type mul(type a, type b) { return _mm_mullo_epi32(a, b); }
+    static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+    static type min(type a, type b) { return _mm_min_epi32(a, b); }
+    static type max(type a, type b) { return _mm_max_epi32(a, b); }
+#  endif
+};
+
+#elif defined(VECTOR_SIMD_NEON)
+
+inline constexpr const char* isa_name = "neon";
+
+template<>
+struct Packet<float> {
+    using type = float32x4_t;
+#  if defined(__aarch64__)
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+#  else
+    static constexpr bool enabled = true, has_mul = true, has_div = false;
+#  endif
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 4;
+    static type load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, type v) { vst1q_f32(p, v); }
+    static type broadcast(float s) { return vdupq_n_f32(s); }
+    static type add(type a, type b) { return vaddq_f32(a, b); }
+    static type sub(type a, type b) { return vsubq_f32(a, b); }
+    static type min(type a, type b) { return vminq_f32(a, b); }
+    static type max(type a, type b) { return vmaxq_f32(a, b); }
+    static type mul(type a, type b) { return vmulq_f32(a, b); }
+#  if defined(__aarch64__)
+    static type fma(type a, type b, type c) { return vfmaq_f32(c, a, b); }
+#  else
+    static type fma(type a, type b, type c) { return vmlaq_f32(c, a, b); }
+#  endif
+#  if defined(__aarch64__)
+    static type div(type a, type b) { return vdivq_f32(a, b); }
+#  endif
+};
+
+#  if defined(__aarch64__)
+template<>
+struct Packet<double> {
+    using type = float64x2_t;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 2;
+    static type load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, type v) { vst1q_f64(p, v); }
+    static type broadcast(double s) { return vdupq_n_f64(s); }
+    static type add(type a, type b) { return vaddq_f64(a, b); }
+    static type sub(type a, type b) { return vsubq_f64(a, b); }
+    static type min(type a, type b) { return vminq_f64(a, b); }
+    static type max(type a, type b) { return vmaxq_f64(a, b); }
+    static type mul(type a, type b) { return vmulq_f64(a, b); }
+    static type fma(type a, type b, type c) { return vfmaq_f64(c, a, b); }
+    static type div(type a, type b) { return vdivq_f64(a, b); }
+};
+#  endif
+
+template<>
+struct Packet<std::int32_t> {
+    using type = int32x4_t;
+    static constexpr bool enabled = true, has_mul = true, has_div = false;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 4;
+    static type load(const std::int32_t* p) { return vld1q_s32(p); }
+    static void store(std::int32_t* p, type v) { vst1q_s32(p, v); }
+    static type broadcast(std::int32_t s) { return vdupq_n_s32(s); }
+    static type add(type a, type b) { return vaddq_s32(a, b); }
+    static type sub(type a, type b) { return vsubq_s32(a, b); }
+    static type min(type a, type b) { return vminq_s32(a, b); }
+    static type max(type a, type b) { return vmaxq_s32(a, b); }
+    static type mul(type a, type b) { return vmulq_s32(a, b); }
+    static type fma(type a, type b, type c) { return vmlaq_s32(c, a, b); }
+};
+
+#else
+
+inline constexpr const char* isa_name = "scalar";
+
+#endif
+
+// Відповідність функтора арифметичній операції над пакетом
+template<typename Op, typename T>
+struct PacketOp {
+    static constexpr bool supported = false;
+};
+
+template<typename T>
+struct PacketOp<std::plus<>, T> {
+    static constexpr bool supported = Packet<T>::enabled;
+    template<typename V> static V run(V a, V b) { return Packet<T>::add(a, b); }
+};
+
+template<typename T>
+struct PacketOp<std::minus<>, T> {
+    static constexpr bool supported = Packet<T>::enabled;
+    template<typename V> static V run(V a, V b) { return Packet<T>::sub(a, b); }
+};
+
+template<typename T>
+struct PacketOp<std::multiplies<>, T> {
+    static constexpr bool supported = Packet<T>::enabled && Packet<T>::has_mul;
+    template<typename V> static V run(V a, V b) { return Packet<T>::mul(a, b); }
+};
+
+template<typename T>
+struct PacketOp<std::divides<>, T> {
+    static constexpr bool supported = Packet<T>::enabled && Packet<T>::has_div;
+    template<typename V> static V run(V a, V b) { return Packet<T>::div(a, b); }
+};
+
+template<typename Op, typename T>
+constexpr bool supports_v = PacketOp<Op, T>::supported;
+
+// Ядра над неперервними масивами: повні пакети + скалярний хвіст
+template<typename T, typename Op>
+void transform(const T* a, const T* b, T* out, std::size_t n, Op op) {
+    std::size_t i = 0;
+    if constexpr (supports_v<Op, T>) {
+        using P = Packet<T>;
+        for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+            P::store(out + i, PacketOp<Op, T>::run(P::load(a + i), P::load(b + i)));
+    }
+    for (; i < n; ++i)
+        out[i] = static_cast<T>(op(a[i], b[i]));
+}
+
+template<typename T, typename Op>
+void transform_scalar(const T* a, T scalar, T* out, std::size_t n, Op op) {
+    std::size_t i = 0;
+    if constexpr (supports_v<Op, T>) {
+        using P = Packet<T>;
+        const auto s = P::broadcast(scalar);
+        for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+            P::store(out + i, PacketOp<Op, T>::run(P::load(a + i), s));
+    }
+    for (; i < n; ++i)
+        out[i] = static_cast<T>(op(a[i], scalar));
+}
+
+// out = alpha * a + beta * b
+template<typename T>
+void axpby(T alpha, const T* a, T beta, const T* b, T* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Packet<T>::enabled && Packet<T>::has_mul) {
+        using P = Packet<T>;
+        const auto va = P::broadcast(alpha);
+        const auto vb = P::broadcast(beta);
+        for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+            P::store(out + i, P::add(P::mul(va, P::load(a + i)), P::mul(vb, P::load(b + i))));
+    }
+    for (; i < n; ++i)
+        out[i] = static_cast<T>(alpha * a[i] + beta * b[i]);
+}
+
+// Скалярне a * b + c: std::fma лише коли воно апаратне (FP_FAST_FMA*),
+// бо програмна std::fma у рази повільніша за окремі множення і додавання
+template<typename T>
+inline constexpr bool fast_fma_v = false;
+#if defined(FP_FAST_FMAF)
+template<>
+inline constexpr bool fast_fma_v<float> = true;
+#endif
+#if defined(FP_FAST_FMA)
+template<>
+inline constexpr bool fast_fma_v<double> = true;
+#endif
+#if defined(FP_FAST_FMAL)
+template<>
+inline constexpr bool fast_fma_v<long double> = true;
+#endif
+
+template<typename T>
+T mul_add(T a, T b, T c) {
+    if constexpr (fast_fma_v<T>)
+        return std::fma(a, b, c);
+    else
+        return static_cast<T>(a * b + c);
+}
+
+// out = coeff[0] * src[0] + ... + coeff[K-1] * src[K-1] за один прохід по пам'яті
+template<typename T, std::size_t K>
+void linear_combination(const std::array<const T*, K>& src, const std::array<T, K>& coeff, T* out, std::size_t n) {
+    static_assert(K > 0, "linear_combination needs at least one term");
+    std::size_t i = 0;
+    if constexpr (Packet<T>::enabled && Packet<T>::has_mul) {
+        using P = Packet<T>;
+        typename P::type c[K];
+        for (std::size_t k = 0; k < K; ++k)
+            c[k] = P::broadcast(coeff[k]);
+        for (const std::size_t full = n - n % P::width; i < full; i += P::width) {
+            auto acc = P::mul(c[0], P::load(src[0] + i));
+            for (std::size_t k = 1; k < K; ++k)
+                acc = P::fma(c[k], P::load(src[k] + i), acc);
+            P::store(out + i, acc);
+        }
+    }
+    for (; i < n; ++i) {
+        T acc = static_cast<T>(coeff[0] * src[0][i]);
+        for (std::size_t k = 1; k < K; ++k)
+            acc = mul_add(coeff[k], src[k][i], acc);
+        out[i] = acc;
+    }
+}
+
+// ---- Згортки: кілька незалежних акумуляторів + горизонтальне згортання пакета ----
+
+template<typename T, typename V, typename F>
+T horizontal(V v, F f) {
+    alignas(64) T lanes[Packet<T>::width];
+    Packet<T>::store(lanes, v);
+    T r = lanes[0];
+    for (std::size_t k = 1; k < Packet<T>::width; ++k)
+        r = f(r, lanes[k]);
+    return r;
+}
+
+template<typename T>
+T sum(const T* p, std::size_t n) {
+    static_assert(Packet<T>::enabled, "simd::sum requires a packet type");
+    using P = Packet<T>;
+    constexpr std::size_t W = P::width;
+    auto a0 = P::broadcast(T{}), a1 = a0, a2 = a0, a3 = a0;
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % (4 * W); i < full; i += 4 * W) {
+        a0 = P::add(a0, P::load(p + i));
+        a1 = P::add(a1, P::load(p + i + W));
+        a2 = P::add(a2, P::load(p + i + 2 * W));
+        a3 = P::add(a3, P::load(p + i + 3 * W));
+    }
+    for (const std::size_t full = n - n % W; i < full; i += W)
+        a0 = P::add(a0, P::load(p + i));
+    T total = horizontal<T>(P::add(P::add(a0, a1), P::add(a2, a3)), std::plus<>{});
+    for (; i < n; ++i)
+        total += p[i];
+    return total;
+}
+
+template<typename T>
+T dot(const T* a, const T* b, std::size_t n) {
+    static_assert(Packet<T>::enabled && Packet<T>::has_mul, "simd::dot requires a packet type with mul");
+    using P = Packet<T>;
+    constexpr std::size_t W = P::width;
+    auto a0 = P::broadcast(T{}), a1 = a0, a2 = a0, a3 = a0;
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % (4 * W); i < full; i += 4 * W) {
+        a0 = P::add(a0, P::mul(P::load(a + i), P::load(b + i)));
+        a1 = P::add(a1, P::mul(P::load(a + i + W), P::load(b + i + W)));
+        a2 = P::add(a2, P::mul(P::load(a + i + 2 * W), P::load(b + i + 2 * W)));
+        a3 = P::add(a3, P::mul(P::load(a + i + 3 * W), P::load(b + i + 3 * W)));
+    }
+    for (const std::size_t full = n - n % W; i < full; i += W)
+        a0 = P::add(a0, P::mul(P::load(a + i), P::load(b + i)));
+    T total = horizontal<T>(P::add(P::add(a0, a1), P::add(a2, a3)), std::plus<>{});
+    for (; i < n; ++i)
+        total += a[i] * b[i];
+    return total;
+}
+
+// n >= Packet<T>::width; порядок обробки NaN не визначений
+template<typename T>
+T min(const T* p, std::size_t n) {
+    static_assert(Packet<T>::enabled && Packet<T>::has_minmax, "simd::min requires a packet type with min");
+    using P = Packet<T>;
+    auto acc = P::load(p);
+    std::size_t i = P::width;
+    for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+        acc = P::min(acc, P::load(p + i));
+    T r = horizontal<T>(acc, [](T x, T y) { return y < x ? y : x; });
+    for (; i < n; ++i)
+        r = p[i] < r ? p[i] : r;
+    return r;
+}
+
+template<typename T>
+T max(const T* p, std::size_t n) {
+    static_assert(Packet<T>::enabled && Packet<T>::has_minmax, "simd::max requires a packet type with max");
+    using P = Packet<T>;
+    auto acc = P::load(p);
+    std::size_t i = P::width;
+    for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+        acc = P::max(acc, P::load(p + i));
+    T r = horizontal<T>(acc, [](T x, T y) { return x < y ? y : x; });
+    for (; i < n; ++i)
+        r = r < p[i] ? p[i] : r;
+    return r;
+}
+
+// y = alpha * x + y
+template<typename T>
+void axpy(T alpha, const T* x, T* y, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Packet<T>::enabled && Packet<T>::has_mul) {
+        using P = Packet<T>;
+        const auto va = P::broadcast(alpha);
+        for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+            P::store(y + i, P::add(P::load(y + i), P::mul(va, P::load(x + i))));
+    }
+    for (; i < n; ++i)
+        y[i] = static_cast<T>(y[i] + alpha * x[i]);
+}
+
+} // namespace simd
+
+// ---- Наближена арифметика: оцінки rcp / rsqrt з уточненням Ньютона-Рафсона ----
+
+namespace simd {
+
+// Апаратна оцінка 1 / x і 1 / sqrt(x) для пакета; без неї ApproxMath виконується точно
+template<typename T>
+struct Estimate {
+    static constexpr bool enabled = false;
+};
+
+#if defined(VECTOR_SIMD_AVX512)
+
+// Повна маска maskz - як у пакетах AVX-512 з vector_dispatch.hpp
+template<>
+struct Estimate<float> {
+    static constexpr bool enabled = true;
+    static __m512 rcp(__m512 x) { return _mm512_maskz_rcp14_ps(0xFFFF, x); }
+    static __m512 rsqrt(__m512 x) { return _mm512_maskz_rsqrt14_ps(0xFFFF, x); }
+};
+
+template<>
+struct Estimate<double> {
+    static constexpr bool enabled = true;
+    static __m512d rcp(__m512d x) { return _mm512_maskz_rcp14_pd(0xFF, x); }
+    static __m512d rsqrt(__m512d x) { return _mm512_maskz_rsqrt14_pd(0xFF, x); }
+};
+
+#elif defined(VECTOR_SIMD_AVX2)
+
+template<>
+struct Estimate<float> {
+    static constexpr bool enabled = true;
+    static __m256 rcp(__m256 x) { return _mm256_rcp_ps(x); }
+    static __m256 rsqrt(__m256 x) { return _mm256_rsqrt_ps(x); }
+};
+
+#elif defined(VECTOR_SIMD_SSE2)
+
+template<>
+struct Estimate<float> {
+    static constexpr bool enabled = true;
+    static __m128 rcp(__m128 x) { return _mm_rcp_ps(x); }
+    static __m128 rsqrt(__m128 x) { return _mm_rsqrt_ps(x); }
+};
+
+#elif defined(VECTOR_SIMD_NEON)
+
+template<>
+struct Estimate<float> {
+    static constexpr bool enabled = true;
+    static float32x4_t rcp(float32x4_t x) { return vrecpeq_f32(x); }
+    static float32x4_t rsqrt(float32x4_t x) { return vrsqrteq_f32(x); }
+};
+
+#endif
+
+template<typename T>
+inline constexpr bool has_estimate_v = Packet<T>::enabled && Estimate<T>::enabled;
+
+// 1 / a: кожен крок x' = x + x * (1 - a * x) приблизно подвоює кількість правильних бітів
+template<unsigned Steps, typename T>
+typename Packet<T>::type reciprocal(typename Packet<T>::type a) {
+    using P = Packet<T>;
+    auto x = Estimate<T>::rcp(a);
+    const auto one = P::broadcast(T(1));
+    for (unsigned s = 0; s < Steps; ++s)
+        x = P::fma(x, P::sub(one, P::mul(a, x)), x);
+    return x;
+}
+
+// 1 / sqrt(a): крок y' = y * (1.5 - 0.5 * a * y * y)
+template<unsigned Steps, typename T>
+typename Packet<T>::type reciprocal_sqrt(typename Packet<T>::type a) {
+    using P = Packet<T>;
+    auto y = Estimate<T>::rsqrt(a);
+    const auto half_a = P::mul(P::broadcast(T(0.5)), a);
+    const auto three_halves = P::broadcast(T(1.5));
+    for (unsigned s = 0; s < Steps; ++s)
+        y = P::mul(y, P::sub(three_halves, P::mul(half_a, P::mul(y, y))));
+    return y;
+}
+
+template<unsigned Steps, typename T>
+T reciprocal_sqrt(T a) {
+    if constexpr (has_estimate_v<T>) {
+        alignas(64) T lanes[Packet<T>::width];
+        Packet<T>::store(lanes, reciprocal_sqrt<Steps, T>(Packet<T>::broadcast(a)));
+        return lanes[0];
+    } else {
+        return T(1) / std::sqrt(a);
+    }
+}
+
+// out = a / b як a * rcp(b); скалярний хвіст ділить точно
+template<unsigned Steps, typename T>
+void divide_approx(const T* a, const T* b, T* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (has_estimate_v<T>) {
+        using P = Packet<T>;
+        for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+            P::store(out + i, P::mul(P::load(a + i), reciprocal<Steps, T>(P::load(b + i))));
+    }
+    for (; i < n; ++i)
+        out[i] = a[i] / b[i];
+}
+
+} // namespace simd
+
+// ---- Перетворення типів: половинна точність, насичення, векторні ядра ----
+
+// Режим округлення дійсного значення до цілого; nearest - до найближчого парного
+enum class Rounding {
+    nearest,
+    toward_zero,
+    down,
+    up
+};
+
+class float16;
+class bfloat16;
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_half_v = std::is_same_v<T, float16> || std::is_same_v<T, bfloat16>;
+
+inline std::uint32_t float_bits(float f) noexcept {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof u);
+    return u;
+}
+
+inline float float_from_bits(std::uint32_t u) noexcept {
+    float f;
+    std::memcpy(&f, &u, sizeof f);
+    return f;
+}
+
+// float -> binary16 з округленням до найближчого парного; NaN лишається (тихим) NaN
+inline std::uint16_t float_to_half(float f) noexcept {
+    std::uint32_t u = float_bits(f);
+    const std::uint32_t sign = (u >> 16) & 0x8000u;
+    u &= 0x7fffffffu;
+    std::uint32_t h;
+    if (u >= 0x47800000u) {                     // |f| >= 65536: нескінченність або NaN
+        h = u > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    } else if (u < 0x38800000u) {               // піднормальне число або нуль у binary16
+        h = float_bits(float_from_bits(u) + 0.5f) - 0x3f000000u;
+    } else {
+        h = (u + 0xc8000fffu + ((u >> 13) & 1u)) >> 13;
+    }
+    return static_cast<std::uint16_t>(h | sign);
+}
+
+inline float half_to_float(std::uint16_t h) noexcept {
+    std::uint32_t u = (h & 0x7fffu) << 13;
+    const std::uint32_t exp = u & 0x0f800000u;
+    u += 0x38000000u;
+    if (exp == 0x0f800000u) {
+        u += 0x38000000u;
+    } else if (exp == 0) {
+        u = float_bits(float_from_bits(u + 0x00800000u) - float_from_bits(0x38800000u));
+    }
+    return float_from_bits(u | (static_cast<std::uint32_t>(h & 0x8000u) << 16));
+}
+
+inline std::uint16_t float_to_bfloat(float f) noexcept {
+    const std::uint32_t u = float_bits(f);
+    if ((u & 0x7fffffffu) > 0x7f800000u)
+        return static_cast<std::uint16_t>((u >> 16) | 0x40u);
+    return static_cast<std::uint16_t>((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+}
+
+inline float bfloat_to_float(std::uint16_t b) noexcept { return float_from_bits(static_cast<std::uint32_t>(b) << 16); }
+
+} // namespace detail
+
+// Типи зберігання без власної арифметики: обчислення ведуться у float.
+// float16 - IEEE 754 binary16, bfloat16 - старші 16 біт float; обидва округлюють до найближчого парного
+class float16 {
+public:
+    constexpr float16() noexcept : bits_(0) {}
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    explicit float16(U value) noexcept : bits_(detail::float_to_half(static_cast<float>(value))) {}
+
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    explicit operator U() const noexcept { return static_cast<U>(detail::half_to_float(bits_)); }
+
+    static constexpr float16 from_bits(std::uint16_t bits) noexcept { return float16(bits, 0); }
+    constexpr std::uint16_t bits() const noexcept { return bits_; }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, float16 h) { return os << static_cast<float>(h); }
+
+private:
+    constexpr float16(std::uint16_t bits, int) noexcept : bits_(bits) {}
+
+    std::uint16_t bits_;
+};
+
+class bfloat16 {
+public:
+    constexpr bfloat16() noexcept : bits_(0) {}
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    explicit bfloat16(U value) noexcept : bits_(detail::float_to_bfloat(static_cast<float>(value))) {}
+
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    explicit operator U() const noexcept { return static_cast<U>(detail::bfloat_to_float(bits_)); }
+
+    static constexpr bfloat16 from_bits(std::uint16_t bits) noexcept { return bfloat16(bits, 0); }
+    constexpr std::uint16_t bits() const noexcept { return bits_; }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, bfloat16 b) { return os << static_cast<float>(b); }
+
+private:
+    constexpr bfloat16(std::uint16_t bits, int) noexcept : bits_(bits) {}
+
+    std::uint16_t bits_;
+};
+
+namespace detail {
+
+// a < b для цілих різної знаковості без неявного перетворення
+template<typename A, typename B>
+constexpr bool int_less(A a, B b) noexcept {
+    if constexpr (std::is_signed_v<A> == std::is_signed_v<B>)
+        return a < b;
+    else if constexpr (std::is_signed_v<A>)
+        return a < 0 || static_cast<std::make_unsigned_t<A>>(a) < b;
+    else
+        return b >= 0 && a < static_cast<std::make_unsigned_t<B>>(b);
+}
+
+} // namespace detail
+
+// Перетворення до цілого D без невизначеної поведінки: значення поза діапазоном
+// обрізаються до min/max, NaN дає 0. Для нецілих D це звичайне static_cast
+template<typename D, typename S>
+constexpr D saturate_cast(S value, Rounding mode = Rounding::nearest) {
+    if constexpr (detail::is_half_v<S>) {
+        return saturate_cast<D>(static_cast<float>(value), mode);
+    } else if constexpr (!std::is_integral_v<D> || std::is_same_v<D, bool>) {
+        return static_cast<D>(value);
+    } else if constexpr (std::is_integral_v<S>) {
+        if (detail::int_less(value, std::numeric_limits<D>::min()))
+            return std::numeric_limits<D>::min();
+        if (detail::int_less(std::numeric_limits<D>::max(), value))
+            return std::numeric_limits<D>::max();
+        return static_cast<D>(value);
+    } else {
+        // lo і limit = max + 1 - степені двійки, тож представлені в S точно
+        constexpr S lo = static_cast<S>(std::numeric_limits<D>::min());
+        constexpr S limit = static_cast<S>(std::numeric_limits<D>::max() / 2 + 1) * S(2);
+        if (value != value)
+            return D(0);
+        if (value >= limit)
+            return std::numeric_limits<D>::max();
+        if (value <= lo)
+            return std::numeric_limits<D>::min();
+        D t = static_cast<D>(value);
+        const S diff = value - static_cast<S>(t);  // точна дробова частина, знак як у value
+        bool up = false, down = false;
+        switch (mode) {
+            case Rounding::toward_zero: break;
+            case Rounding::down: down = diff < 0; break;
+            case Rounding::up: up = diff > 0; break;
+            case Rounding::nearest: {
+                const bool odd = (t % 2) != 0;
+                up = diff > S(0.5) || (diff == S(0.5) && odd);
+                down = diff < S(-0.5) || (diff == S(-0.5) && odd);
+                break;
+            }
+        }
+        if (up && t < std::numeric_limits<D>::max())
+            ++t;
+        if (down)
+            --t;
+        return t;
+    }
+}
+
+namespace detail {
+
+// Поелементне перетворення для convert(): дійсне -> ціле обрізається до
+// діапазону D з відкиданням дробової частини (як static_cast, але без UB)
+template<typename D, typename S>
+constexpr D convert_value(const S& value) {
+    if constexpr (std::is_integral_v<D> && !std::is_same_v<D, bool> &&
+                  (std::is_floating_point_v<S> || is_half_v<S>))
+        return saturate_cast<D>(value, Rounding::toward_zero);
+    else if constexpr (is_half_v<S> && is_half_v<D>)
+        return D(static_cast<float>(value));
+    else
+        return static_cast<D>(value);
+}
+
+} // namespace detail
+
+namespace simd {
+
+template<typename S, typename D>
+inline constexpr bool has_conversion_v =
+    (std::is_arithmetic_v<S> || detail::is_half_v<S>) && (std::is_arithmetic_v<D> || detail::is_half_v<D>);
+
+// *_packets(in, out, n) перетворюють векторно префікс довжини, кратної ширині пакета,
+// і повертають його довжину; решту дообчислює скалярний цикл. Загальний випадок - 0
+template<typename S, typename D>
+std::size_t convert_packets(const S*, D*, std::size_t) { return 0; }
+
+template<typename S, typename D>
+std::size_t saturate_packets(const S*, D*, std::size_t, Rounding) { return 0; }
+
+#if defined(VECTOR_SIMD_AVX512) || defined(VECTOR_SIMD_AVX2) || defined(VECTOR_SIMD_SSE2)
+
+// Ядра на 128-бітних регістрах SSE2 (SSE4.1 - для down/up, F16C - для float16):
+// перетворення впирається в пропускну здатність пам'яті, ширші регістри майже не додають
+
+inline std::size_t convert_packets(const double* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 4; i < full; i += 4)
+        _mm_storeu_ps(out + i, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(in + i)), _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2))));
+    return i;
+}
+
+inline std::size_t convert_packets(const float* in, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 4; i < full; i += 4) {
+        const __m128 x = _mm_loadu_ps(in + i);
+        _mm_storeu_pd(out + i, _mm_cvtps_pd(x));
+        _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+    return i;
+}
+
+inline std::size_t convert_packets(const float* in, bfloat16* out, std::size_t n) {
+    const __m128i bias = _mm_set1_epi32(0x7fff), one = _mm_set1_epi32(1), quiet = _mm_set1_epi32(0x400000);
+    const auto round = [&](__m128 x) {
+        const __m128i u = _mm_castps_si128(x);
+        const __m128i r = _mm_add_epi32(u, _mm_add_epi32(bias, _mm_and_si128(_mm_srli_epi32(u, 16), one)));
+        const __m128i nan = _mm_castps_si128(_mm_cmpunord_ps(x, x));
+        const __m128i v = _mm_or_si128(_mm_and_si128(nan, _mm_or_si128(u, quiet)), _mm_andnot_si128(nan, r));
+        return _mm_srai_epi32(v, 16);  // старші 16 біт зі знаком, щоб packs не насичував
+    };
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 8; i < full; i += 8) {
+        const __m128i lo = round(_mm_loadu_ps(in + i)), hi = round(_mm_loadu_ps(in + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+    }
+    return i;
+}
+
+inline std::size_t convert_packets(const bfloat16* in, float* out, std::size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 8; i < full; i += 8) {
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_ps(out + i, _mm_castsi128_ps(_mm_unpacklo_epi16(zero, b)));
+        _mm_storeu_ps(out + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, b)));
+    }
+    return i;
+}
+
+#  if defined(__F16C__)
+inline std::size_t convert_packets(const float* in, float16* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 4; i < full; i += 4)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_cvtps_ph(_mm_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    return i;
+}
+
+inline std::size_t convert_packets(const float16* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 4; i < full; i += 4)
+        _mm_storeu_ps(out + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i))));
+    return i;
+}
+#  endif
+
+// Знакове розширення цілих: SSE2 розпаковує й зсуває арифметично
+inline __m128i widen_lo_epi16(__m128i v) { return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16); }
+inline __m128i widen_hi_epi16(__m128i v) { return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16); }
+inline __m128i widen_lo_epi8(__m128i v) { return _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8); }
+inline __m128i widen_hi_epi8(__m128i v) { return _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8); }
+
+inline std::size_t convert_packets(const std::int8_t* in, std::int16_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 16; i < full; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), widen_lo_epi8(v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), widen_hi_epi8(v));
+    }
+    return i;
+}
+
+inline std::size_t convert_packets(const std::int16_t* in, std::int32_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 8; i < full; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), widen_lo_epi16(v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), widen_hi_epi16(v));
+    }
+    return i;
+}
+
+inline std::size_t convert_packets(const std::int32_t* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 4; i < full; i += 4)
+        _mm_storeu_ps(out + i, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+    return i;
+}
+
+// Деквантизація: int8/int16 -> float через 32-бітне розширення
+inline std::size_t convert_packets(const std::int16_t* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 8; i < full; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_ps(out + i, _mm_cvtepi32_ps(widen_lo_epi16(v)));
+        _mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(widen_hi_epi16(v)));
+    }
+    return i;
+}
+
+inline std::size_t convert_packets(const std::int8_t* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 16; i < full; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i lo = widen_lo_epi8(v), hi = widen_hi_epi8(v);
+        _mm_storeu_ps(out + i, _mm_cvtepi32_ps(widen_lo_epi16(lo)));
+        _mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(widen_hi_epi16(lo)));
+        _mm_storeu_ps(out + i + 8, _mm_cvtepi32_ps(widen_lo_epi16(hi)));
+        _mm_storeu_ps(out + i + 12, _mm_cvtepi32_ps(widen_hi_epi16(hi)));
+    }
+    return i;
+}
+
+// 4 float -> 4 int32 з округленням M і насиченням до [lo, hi] (для int32 - до меж int32); NaN -> 0
+template<Rounding M, typename D>
+inline __m128i saturate_epi32(__m128 x) {
+    x = _mm_and_ps(x, _mm_cmpord_ps(x, x));
+    if constexpr (!std::is_same_v<D, std::int32_t>) {
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(static_cast<float>(std::numeric_limits<D>::min()))),
+                       _mm_set1_ps(static_cast<float>(std::numeric_limits<D>::max())));
+    }
+    __m128i r;
+    if constexpr (M == Rounding::nearest)
+        r = _mm_cvtps_epi32(x);  // режим MXCSR за замовчуванням - до найближчого парного
+    else if constexpr (M == Rounding::toward_zero)
+        r = _mm_cvttps_epi32(x);
+#  if defined(__SSE4_1__)
+    else if constexpr (M == Rounding::down)
+        r = _mm_cvttps_epi32(_mm_floor_ps(x));
+    else
+        r = _mm_cvttps_epi32(_mm_ceil_ps(x));
+#  endif
+    if constexpr (std::is_same_v<D, std::int32_t>) {
+        // переповнення дає 0x80000000; для x >= 2^31 xor з маскою перетворює його на INT32_MAX
+        r = _mm_xor_si128(r, _mm_castps_si128(_mm_cmpge_ps(x, _mm_set1_ps(2147483648.0f))));
+    }
+    return r;
+}
+
+template<Rounding M, typename D>
+std::size_t saturate_float_packets(const float* in, D* out, std::size_t n) {
+    constexpr std::size_t W = 16 / sizeof(D);
+    const auto q = [in](std::size_t k) { return saturate_epi32<M, D>(_mm_loadu_ps(in + k)); };
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % W; i < full; i += W) {
+        __m128i r;
+        if constexpr (sizeof(D) == 4)
+            r = q(i);
+        else if constexpr (sizeof(D) == 2)
+            r = _mm_packs_epi32(q(i), q(i + 4));
+        else
+            r = _mm_packs_epi16(_mm_packs_epi32(q(i), q(i + 4)), _mm_packs_epi32(q(i + 8), q(i + 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+    }
+    return i;
+}
+
+template<typename D>
+std::size_t saturate_float_packets(const float* in, D* out, std::size_t n, Rounding mode) {
+    switch (mode) {
+        case Rounding::nearest: return saturate_float_packets<Rounding::nearest>(in, out, n);
+        case Rounding::toward_zero: return saturate_float_packets<Rounding::toward_zero>(in, out, n);
+#  if defined(__SSE4_1__)
+        case Rounding::down: return saturate_float_packets<Rounding::down>(in, out, n);
+        case Rounding::up: return saturate_float_packets<Rounding::up>(in, out, n);
+#  endif
+        default: return 0;
+    }
+}
+
+inline std::size_t saturate_packets(const float* in, std::int32_t* out, std::size_t n, Rounding mode) {
+    return saturate_float_packets(in, out, n, mode);
+}
+inline std::size_t saturate_packets(const float* in, std::int16_t* out, std::size_t n, Rounding mode) {
+    return saturate_float_packets(in, out, n, mode);
+}
+inline std::size_t saturate_packets(const float* in, std::int8_t* out, std::size_t n, Rounding mode) {
+    return saturate_float_packets(in, out, n, mode);
+}
+
+// float -> ціле у convert(): відкидання дробової частини з насиченням
+inline std::size_t convert_packets(const float* in, std::int32_t* out, std::size_t n) {
+    return saturate_float_packets<Rounding::toward_zero>(in, out, n);
+}
+inline std::size_t convert_packets(const float* in, std::int16_t* out, std::size_t n) {
+    return saturate_float_packets<Rounding::toward_zero>(in, out, n);
+}
+inline std::size_t convert_packets(const float* in, std::int8_t* out, std::size_t n) {
+    return saturate_float_packets<Rounding::toward_zero>(in, out, n);
+}
+
+// Звуження цілих з насиченням: packs робить саме це
+inline std::size_t saturate_packets(const std::int32_t* in, std::int16_t* out, std::size_t n, Rounding) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 8; i < full; i += 8) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(in + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)));
+    }
+    return i;
+}
+
+inline std::size_t saturate_packets(const std::int32_t* in, std::int8_t* out, std::size_t n, Rounding) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 16; i < full; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(in + i);
+        const __m128i lo = _mm_packs_epi32(_mm_loadu_si128(p), _mm_loadu_si128(p + 1));
+        const __m128i hi = _mm_packs_epi32(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi16(lo, hi));
+    }
+    return i;
+}
+
+inline std::size_t saturate_packets(const std::int16_t* in, std::int8_t* out, std::size_t n, Rounding) {
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 16; i < full; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(in + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi16(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)));
+    }
+    return i;
+}
+
+#endif
+
+// out[i] = convert_value<D>(in[i]); дійсне -> ціле насичується, а не дає UB
+template<typename S, typename D>
+void convert(const S* in, D* out, std::size_t n) {
+    std::size_t i = convert_packets(in, out, n);
+    for (; i < n; ++i)
+        out[i] = detail::convert_value<D>(in[i]);
+}
+
+// out[i] = saturate_cast<D>(in[i], mode)
+template<typename S, typename D>
+void saturate_convert(const S* in, D* out, std::size_t n, Rounding mode = Rounding::nearest) {
+    std::size_t i = saturate_packets(in, out, n, mode);
+    for (; i < n; ++i)
+        out[i] = saturate_cast<D>(in[i], mode);
+}
+
+} // namespace simd
+
+namespace detail {
+
+// Вирівнювання за замовчуванням: найбільше з 64/32/16 байт, на яке ділиться
+// розмір даних. Воно ніколи не додає доповнення, тож масиви Vector<T, N>
+// лишаються щільними, а sizeof(Vector<T, N>) == N * sizeof(T).
+template<typename T, std::size_t N>
+constexpr std::size_t auto_vector_alignment() {
+    constexpr std::size_t bytes = N * sizeof(T);
+    if constexpr (!std::is_arithmetic_v<T> || bytes == 0) {
+        return alignof(T);
+    } else {
+        constexpr std::size_t a = bytes % 64 == 0 ? 64 : bytes % 32 == 0 ? 32 : bytes % 16 == 0 ? 16 : 1;
+        return a > alignof(T) ? a : alignof(T);
+    }
+}
+
+constexpr std::size_t round_up(std::size_t n, std::size_t m) noexcept { return (n + m - 1) / m * m; }
+
+} // namespace detail
+
+// Align - вирівнювання сховища в байтах. Явне Align більше за розмір даних
+// доповнює сховище до кратного Align (Vector<float, 3, 16> займає 16 байт); ядра
+// SIMD тоді обробляють і доповнення, без скалярного хвоста. size() завжди N.
+template<typename T, std::size_t N, std::size_t Align = detail::auto_vector_alignment<T, N>()>
+class Vector;
+
+// Крок представлення, відомий лише під час виконання
+inline constexpr std::ptrdiff_t dynamic_stride = std::numeric_limits<std::ptrdiff_t>::min();
+
+template<typename T, std::size_t N, std::ptrdiff_t Stride = 1>
+class VectorView;
+
+template<typename T>
+struct is_vector : std::false_type {};
+
+template<typename T, std::size_t N, std::size_t A>
+struct is_vector<Vector<T, N, A>> : std::true_type {};
+
+// Ознака лінивого виразу (вузли шаблонів виразів оголошуються нижче)
+template<typename T>
+struct is_vector_expression : std::false_type {};
+
+template<typename T>
+constexpr bool is_vector_v = is_vector<std::decay_t<T>>::value;
+
+template<typename T>
+constexpr bool is_vector_expression_v = is_vector_expression<std::decay_t<T>>::value;
+
+template<typename T>
+constexpr bool is_vector_operand_v = is_vector_v<T> || is_vector_expression_v<T>;
+
+// SparseVector (vector_sparse.hpp) має власні оператори, тож шаблони виразів не беруть його за скаляр
+template<typename T>
+struct is_sparse_vector : std::false_type {};
+
+template<typename T>
+constexpr bool is_sparse_vector_v = is_sparse_vector<std::decay_t<T>>::value;
+
+// Векторні інтринсики не можна викликати під час обчислення на етапі компіляції
+#if defined(__cpp_lib_is_constant_evaluated)
+#  define VECTOR_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#  define VECTOR_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#  define VECTOR_IS_CONSTANT_EVALUATED() true
+#endif
+
+// Перевірка меж у operator[]: за замовчуванням вимкнена лише в релізних збірках (NDEBUG).
+// at() перевіряє межі завжди (за політикою VECTOR_ERROR_POLICY нижче), try_at() повертає
+// Expected замість помилки, at_unchecked() і get<I>() не перевіряють ніколи.
+#ifndef VECTOR_CHECKED_ACCESS
+#  ifdef NDEBUG
+#    define VECTOR_CHECKED_ACCESS 0
+#  else
+#    define VECTOR_CHECKED_ACCESS 1
+#  endif
+#endif
+
+// ---- Політика помилок: виняток, assert або terminate ----
+
+// VECTOR_ERROR_POLICY визначає, що відбувається при порушенні контракту (індекс поза межами,
+// різні розміри) або збої вводу/виводу:
+//   VECTOR_ERROR_THROW     - виняток std::out_of_range / invalid_argument / runtime_error;
+//   VECTOR_ERROR_ASSERT    - повідомлення в stderr і abort(); з NDEBUG перевірки контрактів
+//                            (зокрема в at()) не компілюються зовсім, лишаються лише збої вводу/виводу;
+//   VECTOR_ERROR_TERMINATE - повідомлення в stderr і std::terminate().
+// За замовчуванням - THROW, а при -fno-exceptions - TERMINATE. try_at() не залежить від політики.
+#define VECTOR_ERROR_THROW 0
+#define VECTOR_ERROR_ASSERT 1
+#define VECTOR_ERROR_TERMINATE 2
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#  define VECTOR_HAS_EXCEPTIONS 1
+#else
+#  define VECTOR_HAS_EXCEPTIONS 0
+#endif
+
+#ifndef VECTOR_ERROR_POLICY
+#  if VECTOR_HAS_EXCEPTIONS
+#    define VECTOR_ERROR_POLICY VECTOR_ERROR_THROW
+#  else
+#    define VECTOR_ERROR_POLICY VECTOR_ERROR_TERMINATE
+#  endif
+#endif
+
+#if VECTOR_ERROR_POLICY == VECTOR_ERROR_THROW && !VECTOR_HAS_EXCEPTIONS
+#  error "VECTOR_ERROR_THROW requires exceptions; use VECTOR_ERROR_ASSERT or VECTOR_ERROR_TERMINATE"
+#endif
+
+// Холодна функція не вбудовується і лежить окремо від гарячого коду
+#if defined(__GNUC__) || defined(__clang__)
+#  define VECTOR_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#  define VECTOR_COLD __declspec(noinline)
+#else
+#  define VECTOR_COLD
+#endif
+
+// Перевірка контракту: з VECTOR_ERROR_ASSERT і NDEBUG зникає, інакше при невиконанні викликає fail
+#if VECTOR_ERROR_POLICY == VECTOR_ERROR_ASSERT && defined(NDEBUG)
+#  define VECTOR_EXPECTS(cond, fail) ((void)0)
+#else
+#  define VECTOR_EXPECTS(cond, fail) do { if (!(cond)) fail; } while (false)
+#endif
+
+namespace detail {
+
+// Точка виходу всіх помилок бібліотеки; E - тип винятку для VECTOR_ERROR_THROW
+template<typename E>
+[[noreturn]] VECTOR_COLD void raise_error(const char* message) {
+#if VECTOR_ERROR_POLICY == VECTOR_ERROR_THROW
+    throw E(message);
+#else
+    std::fputs(message, stderr);
+    std::fputc('\n', stderr);
+#  if VECTOR_ERROR_POLICY == VECTOR_ERROR_ASSERT
+    std::abort();
+#  else
+    std::terminate();
+#  endif
+#endif
+}
+
+} // namespace detail
+
+enum class VectorErrc {
+    out_of_range = 1,
+    size_mismatch
+};
+
+// Опис помилки для try_at(): index - запитаний індекс, size - розмір вектора
+struct VectorError {
+    VectorErrc code;
+    std::ptrdiff_t index;
+    std::size_t size;
+};
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+
+template<typename T>
+using Expected = std::expected<T, VectorError>;
+
+namespace detail {
+constexpr std::unexpected<VectorError> unexpected_error(VectorError e) noexcept { return std::unexpected<VectorError>(e); }
+} // namespace detail
+
+#else
+
+namespace detail {
+struct UnexpectedError {
+    VectorError error;
+};
+constexpr UnexpectedError unexpected_error(VectorError e) noexcept { return {e}; }
+} // namespace detail
+
+// Замінник std::expected<T, VectorError> до C++23 з тим самим інтерфейсом
+template<typename T>
+class Expected {
+public:
+    using value_type = T;
+    using error_type = VectorError;
+
+    constexpr Expected(const T& value) : value_(value), error_{}, has_value_(true) {}
+    constexpr Expected(detail::UnexpectedError e) : value_{}, error_(e.error), has_value_(false) {}
+
+    constexpr bool has_value() const noexcept { return has_value_; }
+    constexpr explicit operator bool() const noexcept { return has_value_; }
+
+    constexpr const T& value() const {
+        if (!has_value_)
+            detail::raise_error<std::logic_error>("bad Expected access");
+        return value_;
+    }
+    constexpr const T& operator*() const noexcept { return value_; }
+    constexpr const T* operator->() const noexcept { return &value_; }
+    constexpr const VectorError& error() const noexcept { return error_; }
+
+    template<typename U>
+    constexpr T value_or(U&& fallback) const {
+        return has_value_ ? value_ : static_cast<T>(std::forward<U>(fallback));
+    }
+
+private:
+    T value_;
+    VectorError error_;
+    bool has_value_;
+};
+
+#endif
+
+// ---- Інструментування: лічильники операцій і трасування (-DVECTOR_INSTRUMENTATION=1) ----
+
+// За замовчуванням усі точки вимірювання компілюються в порожні оператори.
+// API нижче доступне завжди; без інструментування snapshot() повертає нулі.
+#ifndef VECTOR_INSTRUMENTATION
+#  define VECTOR_INSTRUMENTATION 0
+#endif
+
+namespace instrumentation {
+
+inline constexpr bool enabled = VECTOR_INSTRUMENTATION != 0;
+
+enum class Op : std::size_t {
+    add, sub, mul, div, weighted_sum, axpy, concat, convert, resize, slice, reduce, batch, count_
+};
+
+inline constexpr std::size_t op_count = static_cast<std::size_t>(Op::count_);
+
+constexpr const char* op_name(Op op) noexcept {
+    constexpr const char* names[op_count] = {
+        "add", "sub", "mul", "div", "weighted_sum", "axpy", "concat", "convert", "resize", "slice", "reduce", "batch"
+    };
+    return names[static_cast<std::size_t>(op)];
+}
+
+// Операція, якій відповідає функтор виразу чи складеного присвоєння
+template<typename F>
+constexpr Op op_of() noexcept {
+    if constexpr (std::is_same_v<F, std::minus<>>) return Op::sub;
+    else if constexpr (std::is_same_v<F, std::multiplies<>>) return Op::mul;
+    else if constexpr (std::is_same_v<F, std::divides<>>) return Op::div;
+    else return Op::add;
+}
+
+struct OpCounters {
+    std::uint64_t calls = 0;
+    std::uint64_t elements = 0;
+};
+
+// temporaries - вектори, обчислені з лінивих виразів (кожен - окремий прохід і сховище);
+// promotions - операції, де тип результату ширший за тип векторного операнда
+struct Snapshot {
+    std::array<OpCounters, op_count> ops{};
+    std::uint64_t temporaries = 0;
+    std::uint64_t out_of_range = 0;
+    std::uint64_t promotions = 0;
+
+    const OpCounters& operator[](Op op) const noexcept { return ops[static_cast<std::size_t>(op)]; }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const Snapshot& s) {
+        for (std::size_t i = 0; i < op_count; ++i) {
+            if (s.ops[i].calls == 0)
+                continue;
+            os << op_name(static_cast<Op>(i)) << ": calls=" << s.ops[i].calls
+               << " elements=" << s.ops[i].elements << "\n";
+        }
+        os << "temporaries=" << s.temporaries << " out_of_range=" << s.out_of_range
+           << " promotions=" << s.promotions << "\n";
+        return os;
+    }
+};
+
+namespace detail {
+
+struct alignas(64) AtomicOpCounters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> elements{0};
+};
+
+struct TraceEvent {
+    const char* name;
+    std::int64_t begin_ns;
+    std::int64_t duration_ns;
+    std::uint32_t thread;
+};
+
+struct State {
+    std::array<AtomicOpCounters, op_count> ops;
+    alignas(64) std::atomic<std::uint64_t> temporaries{0};
+    std::atomic<std::uint64_t> out_of_range{0};
+    std::atomic<std::uint64_t> promotions{0};
+
+    alignas(64) std::atomic<bool> tracing{false};
+    std::atomic<std::uint32_t> next_thread{0};
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::mutex trace_mutex;
+    std::vector<TraceEvent> events;
+};
+
+inline State& state() {
+    static State s;
+    return s;
+}
+
+inline std::uint32_t thread_id() {
+    thread_local const std::uint32_t id = state().next_thread.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+inline std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - state().epoch).count();
+}
+
+} // namespace detail
+
+inline void count_call(Op op, std::size_t elements) noexcept {
+    auto& c = detail::state().ops[static_cast<std::size_t>(op)];
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    c.elements.fetch_add(elements, std::memory_order_relaxed);
+}
+
+inline void count_temporary() noexcept { detail::state().temporaries.fetch_add(1, std::memory_order_relaxed); }
+inline void count_out_of_range() noexcept { detail::state().out_of_range.fetch_add(1, std::memory_order_relaxed); }
+inline void count_promotion() noexcept { detail::state().promotions.fetch_add(1, std::memory_order_relaxed); }
+
+inline Snapshot snapshot() noexcept {
+    const detail::State& st = detail::state();
+    Snapshot s;
+    for (std::size_t i = 0; i < op_count; ++i) {
+        s.ops[i].calls = st.ops[i].calls.load(std::memory_order_relaxed);
+        s.ops[i].elements = st.ops[i].elements.load(std::memory_order_relaxed);
+    }
+    s.temporaries = st.temporaries.load(std::memory_order_relaxed);
+    s.out_of_range = st.out_of_range.load(std::memory_order_relaxed);
+    s.promotions = st.promotions.load(std::memory_order_relaxed);
+    return s;
+}
+
+inline void reset() noexcept {
+    detail::State& st = detail::state();
+    for (auto& c : st.ops) {
+        c.calls.store(0, std::memory_order_relaxed);
+        c.elements.store(0, std::memory_order_relaxed);
+    }
+    st.temporaries.store(0, std::memory_order_relaxed);
+    st.out_of_range.store(0, std::memory_order_relaxed);
+    st.promotions.store(0, std::memory_order_relaxed);
+}
+
+// Починає збирати інтервали Span у пам'яті; stop_trace() записує їх у форматі
+// Chrome Trace Event (відкривається в Perfetto або chrome://tracing)
+inline void start_trace() {
+    detail::State& st = detail::state();
+    std::lock_guard<std::mutex> lock(st.trace_mutex);
+    st.events.clear();
+    st.tracing.store(true, std::memory_order_release);
+}
+
+inline bool stop_trace(const std::string& path) {
+    detail::State& st = detail::state();
+    st.tracing.store(false, std::memory_order_release);
+    std::vector<detail::TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(st.trace_mutex);
+        events.swap(st.events);
+    }
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (!out)
+        return false;
+    std::fputs("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n", out);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const detail::TraceEvent& e = events[i];
+        std::fprintf(out, "{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}%s",
+                     e.name, static_cast<unsigned>(e.thread), static_cast<double>(e.begin_ns) / 1000.0,
+                     static_cast<double>(e.duration_ns) / 1000.0, i + 1 < events.size() ? ",\n" : "\n");
+    }
+    std::fputs("]}\n", out);
+    const bool ok = !std::ferror(out);
+    return std::fclose(out) == 0 && ok;
+}
+
+// Інтервал [створення, знищення); поза start_trace()/stop_trace() нічого не записує.
+// name має жити до stop_trace() (зазвичай це рядковий літерал).
+class Span {
+public:
+    explicit Span(const char* name) noexcept
+        : name_(name), begin_(detail::state().tracing.load(std::memory_order_relaxed) ? detail::now_ns() : -1) {}
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    ~Span() {
+        if (begin_ < 0 || !detail::state().tracing.load(std::memory_order_relaxed))
+            return;
+        const detail::TraceEvent e{name_, begin_, detail::now_ns() - begin_, detail::thread_id()};
+        detail::State& st = detail::state();
+        std::lock_guard<std::mutex> lock(st.trace_mutex);
+        st.events.push_back(e);
+    }
+
+private:
+    const char* name_;
+    std::int64_t begin_;
+};
+
+} // namespace instrumentation
+
+#if VECTOR_INSTRUMENTATION
+#  define VECTOR_INSTRUMENT_IF_RUNTIME(stmt) \
+       do { if (!VECTOR_IS_CONSTANT_EVALUATED()) { stmt; } } while (false)
+#  define VECTOR_COUNT_CALL(op, n) VECTOR_INSTRUMENT_IF_RUNTIME(::instrumentation::count_call((op), (n)))
+#  define VECTOR_COUNT_TEMPORARY() VECTOR_INSTRUMENT_IF_RUNTIME(::instrumentation::count_temporary())
+#  define VECTOR_COUNT_PROMOTION_IF(cond) \
+       VECTOR_INSTRUMENT_IF_RUNTIME(if (cond) ::instrumentation::count_promotion())
+#  define VECTOR_COUNT_OUT_OF_RANGE() ::instrumentation::count_out_of_range()
+#  define VECTOR_TRACE_CONCAT_(a, b) a##b
+#  define VECTOR_TRACE_CONCAT(a, b) VECTOR_TRACE_CONCAT_(a, b)
+#  define VECTOR_TRACE_SPAN(name) ::instrumentation::Span VECTOR_TRACE_CONCAT(vector_trace_span_, __LINE__)(name)
+#else
+#  define VECTOR_COUNT_CALL(op, n) ((void)0)
+#  define VECTOR_COUNT_TEMPORARY() ((void)0)
+#  define VECTOR_COUNT_PROMOTION_IF(cond) ((void)0)
+#  define VECTOR_COUNT_OUT_OF_RANGE() ((void)0)
+#  define VECTOR_TRACE_SPAN(name) ((void)0)
+#endif
+
+namespace detail {
+
+// Від'ємний індекс відраховується з кінця, без перевірки меж
+constexpr std::size_t wrap_index(int index, std::size_t n) noexcept {
+    return static_cast<std::size_t>(index < 0 ? static_cast<int>(n) + index : index);
+}
+
+// Формування повідомлення - у холодній функції поза constexpr-шляхом: гарячий код
+// лишається порівнянням і переходом, а на етапі компіляції вихід за межі робить вираз не константним
+[[noreturn]] VECTOR_COLD inline void fail_out_of_range(int index, std::size_t n) {
+    VECTOR_COUNT_OUT_OF_RANGE();
+    char message[96];
+    std::snprintf(message, sizeof message, "Index %d out of range for Vector<%zu>", index, n);
+    raise_error<std::out_of_range>(message);
+}
+
+constexpr bool index_in_range(int index, std::size_t n) noexcept {
+    const int idx = (index < 0 ? static_cast<int>(n) + index : index);
+    return idx >= 0 && idx < static_cast<int>(n);
+}
+
+constexpr std::size_t normalize_index(int index, std::size_t n) {
+    VECTOR_EXPECTS(index_in_range(index, n), fail_out_of_range(index, n));
+    return wrap_index(index, n);
+}
+
+// Для try_at(): помилка повертається, а не повідомляється політикою
+template<typename T>
+constexpr Expected<T> checked_element(const T* data, int index, std::size_t n) {
+    if (!index_in_range(index, n))
+        return unexpected_error(VectorError{VectorErrc::out_of_range, index, n});
+    return data[wrap_index(index, n)];
+}
+
+// Індекс для operator[]: перевіряється лише коли VECTOR_CHECKED_ACCESS != 0
+constexpr std::size_t access_index(int index, std::size_t n) {
+#if VECTOR_CHECKED_ACCESS
+    return normalize_index(index, n);
+#else
+    return wrap_index(index, n);
+#endif
+}
+
+// Чи може вираз E обчислюватися пакетами типу T (уточнюється для вузлів нижче)
+template<typename E, typename T>
+struct packet_evaluable : std::false_type {};
+
+template<typename T, std::size_t N, std::size_t A>
+struct packet_evaluable<Vector<T, N, A>, T> : std::bool_constant<simd::Packet<T>::enabled> {};
+
+template<typename E, typename T>
+constexpr bool packet_evaluable_v = packet_evaluable<std::decay_t<E>, T>::value;
+
+// Елементи лежать підряд і доступні через data()
+template<typename E>
+struct is_contiguous : std::false_type {};
+
+template<typename T, std::size_t N, std::size_t A>
+struct is_contiguous<Vector<T, N, A>> : std::true_type {};
+
+template<typename T, std::size_t N>
+struct is_contiguous<VectorView<T, N, 1>> : std::true_type {};
+
+template<typename E>
+constexpr bool is_contiguous_v = is_contiguous<std::decay_t<E>>::value;
+
+// Скільки елементів виразу можна читати пакетами: для Vector - разом із доповненням
+// сховища, для вузлів - мінімум по операндах (уточнюється для вузлів нижче)
+template<typename E>
+struct storage_extent : std::integral_constant<std::size_t, std::decay_t<E>::dimension> {};
+
+template<typename T, std::size_t N, std::size_t A>
+struct storage_extent<Vector<T, N, A>> : std::integral_constant<std::size_t, Vector<T, N, A>::storage_size> {};
+
+template<typename E>
+constexpr std::size_t storage_extent_v = storage_extent<std::decay_t<E>>::value;
+
+// Межа пакетного циклу: N з повним останнім пакетом, якщо доповнення всіх
+// сховищ його вміщує, інакше N (і тоді працює скалярний хвіст)
+template<typename T, std::size_t N, std::size_t Extent>
+constexpr std::size_t packet_bound() {
+    constexpr std::size_t W = simd::Packet<T>::width;
+    return Extent >= round_up(N, W) ? round_up(N, W) : N;
+}
+
+// Вираз читає чужу пам'ять через представлення, тож може перекриватися з приймачем
+template<typename E>
+struct contains_view : std::false_type {};
+
+template<typename T, std::size_t N, std::ptrdiff_t Stride>
+struct contains_view<VectorView<T, N, Stride>> : std::true_type {};
+
+template<typename E>
+constexpr bool contains_view_v = contains_view<std::decay_t<E>>::value;
+
+[[noreturn]] VECTOR_COLD inline void fail_view_out_of_range(std::ptrdiff_t first, std::ptrdiff_t last, std::size_t n) {
+    VECTOR_COUNT_OUT_OF_RANGE();
+    char message[128];
+    std::snprintf(message, sizeof message, "View [%td .. %td] out of range for Vector<%zu>", first, last, n);
+    raise_error<std::out_of_range>(message);
+}
+
+constexpr void check_view_range(std::size_t offset, std::size_t m, std::ptrdiff_t stride, std::size_t n) {
+    if (m == 0)
+        return;
+    const std::ptrdiff_t first = static_cast<std::ptrdiff_t>(offset);
+    const std::ptrdiff_t last = first + static_cast<std::ptrdiff_t>(m - 1) * stride;
+    const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(n);
+    VECTOR_EXPECTS(first < size && last >= 0 && last < size, fail_view_out_of_range(first, last, n));
+}
+
+// Скаляр одразу приводиться до типу результату, як і при звичайному перетворенні
+template<typename T, typename U>
+using scalar_storage_t = std::conditional_t<std::is_arithmetic_v<T> && std::is_arithmetic_v<std::decay_t<U>>,
+                                            Promote<T, std::decay_t<U>>, std::decay_t<U>>;
+
+template<std::size_t Extent, typename T, typename E>
+constexpr void evaluate_into(T* out, const E& expr);
+
+template<typename T, typename E>
+auto packet_element(const E& e, std::size_t i);
+
+template<typename E>
+constexpr decltype(auto) element(const E& e, std::size_t i);
+
+// Елемент джерела V: переміщується, якщо V - тимчасовий Vector (не посилання)
+template<typename V, typename Src>
+constexpr decltype(auto) forward_element(Src& src, std::size_t i) {
+    if constexpr (!std::is_lvalue_reference_v<V> && is_vector_v<V>)
+        return std::move(src.at_unchecked(i));
+    else
+        return static_cast<const Src&>(src).at_unchecked(i);
+}
+
+// Діапазони до unroll_limit елементів розгортаються згорткою: для 2-4 компонент
+// після -O2 не лишається ні лічильника циклу, ні переходів
+constexpr std::size_t unroll_limit = 4;
+
+template<std::size_t Begin, typename F, std::size_t... I>
+constexpr void unrolled_for(const F& f, std::index_sequence<I...>) {
+    (f(Begin + I), ...);
+}
+
+// f(i) для кожного i з [Begin, End)
+template<std::size_t Begin, std::size_t End, typename F>
+constexpr void static_for(const F& f) {
+    static_assert(Begin <= End, "invalid static_for range");
+    if constexpr (End - Begin <= unroll_limit) {
+        unrolled_for<Begin>(f, std::make_index_sequence<End - Begin>{});
+    } else {
+        for (std::size_t i = Begin; i < End; ++i)
+            f(i);
+    }
+}
+
+// Малі вектори - розгорнутим скалярним кодом, більші - ядрами simd::convert
+template<std::size_t N, typename S, typename D>
+constexpr void convert_elements(const S* in, D* out) {
+    if (N > unroll_limit && !VECTOR_IS_CONSTANT_EVALUATED()) {
+        simd::convert(in, out, N);
+    } else {
+        static_for<0, N>([in, out](std::size_t i) { out[i] = convert_value<D>(in[i]); });
+    }
+}
+
+} // namespace detail
+
+template<typename T, std::size_t N, std::size_t Align>
+class Vector {
+public:
+    using value_type = T;
+    static constexpr std::size_t dimension = N;
+    static constexpr std::size_t alignment = Align;
+    static constexpr std::size_t storage_size =
+        N == 0 ? 0 : detail::round_up(N * sizeof(T), Align) / sizeof(T);
+    static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T), "invalid Vector alignment");
+
+    constexpr Vector() : data_{} {}
+    constexpr explicit Vector(const T& value) : data_{} {
+        detail::static_for<0, N>([this, &value](std::size_t i) { data_[i] = value; });
+    }
+    constexpr Vector(const Vector& other) = default;
+    constexpr Vector(Vector&& other) = default;
+
+    // Для арифметичних і half-типів - як convert<T>(): векторні ядра, дійсне -> ціле з насиченням
+    template<typename U, std::size_t A>
+    constexpr Vector(const Vector<U, N, A>& other) : data_{} {
+        if constexpr (simd::has_conversion_v<U, T>) {
+            detail::convert_elements<N>(other.data(), data_.data());
+        } else {
+            detail::static_for<0, N>([this, &other](std::size_t i) {
+                data_[i] = static_cast<T>(other.at_unchecked(i));
+            });
+        }
+    }
+
+    // Переміщення має сенс лише для неарифметичних U; числа йдуть тими самими ядрами
+    template<typename U, std::size_t A>
+    constexpr Vector(Vector<U, N, A>&& other) : data_{} {
+        if constexpr (simd::has_conversion_v<U, T>) {
+            detail::convert_elements<N>(other.data(), data_.data());
+        } else {
+            detail::static_for<0, N>([this, &other](std::size_t i) {
+                data_[i] = static_cast<T>(std::move(other.at_unchecked(i)));
+            });
+        }
+    }
+
+    // Обчислення лінивого виразу одним проходом, без проміжних векторів
+    template<typename E, std::enable_if_t<is_vector_expression_v<E> &&
+                                          std::decay_t<E>::dimension == N, int> = 0>
+    constexpr Vector(const E& expr) : data_{} {
+        VECTOR_COUNT_TEMPORARY();
+        assign_expression(expr);
+    }
+
+    constexpr Vector& operator=(const Vector& other) = default;
+    constexpr Vector& operator=(Vector&& other) = default;
+
+    template<typename E, std::enable_if_t<is_vector_expression_v<E> &&
+                                          std::decay_t<E>::dimension == N, int> = 0>
+    constexpr Vector& operator=(const E& expr) {
+        if constexpr (detail::contains_view_v<E>) {
+            // Представлення може дивитися на цей самий вектор (наприклад, у зворотному порядку)
+            *this = Vector(expr);
+        } else {
+            assign_expression(expr);
+        }
+        return *this;
+    }
+
+    // Складене присвоєння пише прямо в data_, без тимчасового вектора
+    template<typename U>
+    constexpr Vector& operator+=(const U& rhs) { return apply_in_place(rhs, std::plus<>{}); }
+    template<typename U>
+    constexpr Vector& operator-=(const U& rhs) { return apply_in_place(rhs, std::minus<>{}); }
+    template<typename U>
+    constexpr Vector& operator*=(const U& rhs) { return apply_in_place(rhs, std::multiplies<>{}); }
+    template<typename U>
+    constexpr Vector& operator/=(const U& rhs) { return apply_in_place(rhs, std::divides<>{}); }
+
+    constexpr T& operator[](int index) { return data_[detail::access_index(index, N)]; }
+    constexpr const T& operator[](int index) const { return data_[detail::access_index(index, N)]; }
+
+    constexpr T& at(int index) { return data_[detail::normalize_index(index, N)]; }
+    constexpr const T& at(int index) const { return data_[detail::normalize_index(index, N)]; }
+
+    // Копія елемента або VectorError{out_of_range}; перевіряє межі за будь-якої політики помилок
+    constexpr Expected<T> try_at(int index) const { return detail::checked_element(data(), index, N); }
+
+    constexpr T& at_unchecked(std::size_t index) noexcept { return data_[index]; }
+    constexpr const T& at_unchecked(std::size_t index) const noexcept { return data_[index]; }
+
+    template<int I>
+    constexpr T& get() noexcept { return data_[checked_static_index<I>()]; }
+    template<int I>
+    constexpr const T& get() const noexcept { return data_[checked_static_index<I>()]; }
+
+    // Іменовані компоненти; y() потребує N >= 2, z() - N >= 3, w() - N >= 4. Це шаблони (M = N),
+    // щоб явна інстанціація Vector<T, 2> не інстанціювала z(), w() і тривимірні перестановки
+    template<std::size_t M = N>
+    constexpr T& x() noexcept { return get<0>(); }
+    template<std::size_t M = N>
+    constexpr T& y() noexcept { return get<1>(); }
+    template<std::size_t M = N>
+    constexpr T& z() noexcept { return get<2>(); }
+    template<std::size_t M = N>
+    constexpr T& w() noexcept { return get<3>(); }
+    template<std::size_t M = N>
+    constexpr const T& x() const noexcept { return get<0>(); }
+    template<std::size_t M = N>
+    constexpr const T& y() const noexcept { return get<1>(); }
+    template<std::size_t M = N>
+    constexpr const T& z() const noexcept { return get<2>(); }
+    template<std::size_t M = N>
+    constexpr const T& w() const noexcept { return get<3>(); }
+
+    // Новий вектор з компонент I...: swizzle<2, 1, 0>() обертає порядок, індекси можуть повторюватися
+    template<std::size_t... I>
+    constexpr Vector<T, sizeof...(I)> swizzle() const {
+        static_assert(sizeof...(I) > 0, "swizzle needs at least one index");
+        static_assert(((I < N) && ...), "swizzle index out of range");
+        Vector<T, sizeof...(I)> result;
+        std::size_t k = 0;
+        ((result.at_unchecked(k++) = data_[I]), ...);
+        return result;
+    }
+
+    // Найуживаніші перестановки; решту дає swizzle<...>()
+    template<std::size_t M = N>
+    constexpr Vector<T, 2> xy() const { return swizzle<0, 1>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 2> yx() const { return swizzle<1, 0>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 2> xz() const { return swizzle<0, 2>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 2> yz() const { return swizzle<1, 2>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 3> xyz() const { return swizzle<0, 1, 2>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 3> xzy() const { return swizzle<0, 2, 1>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 3> yxz() const { return swizzle<1, 0, 2>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 3> yzx() const { return swizzle<1, 2, 0>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 3> zxy() const { return swizzle<2, 0, 1>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 3> zyx() const { return swizzle<2, 1, 0>(); }
+    template<std::size_t M = N>
+    constexpr Vector<T, 4> wzyx() const { return swizzle<3, 2, 1, 0>(); }
+
+    constexpr std::size_t size() const noexcept { return N; }
+
+    constexpr T* data() noexcept { return data_.data(); }
+    constexpr const T* data() const noexcept { return data_.data(); }
+
+    constexpr auto begin() noexcept { return data_.begin(); }
+    constexpr auto end() noexcept { return data_.begin() + N; }
+    constexpr auto begin() const noexcept { return data_.begin(); }
+    constexpr auto end() const noexcept { return data_.begin() + N; }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const Vector& v) {
+        os << "[";
+        for (std::size_t i = 0; i < N; ++i) {
+            os << v.data_[i] << (i + 1 < N ? ", " : "");
+        }
+        os << "]";
+        return os;
+    }
+
+    // Перевантаження && переміщують елементи з тимчасового вектора замість копіювання
+    template<std::size_t M>
+    constexpr auto resize() const& { return resize_from<M>(*this); }
+    template<std::size_t M>
+    constexpr auto resize() && { return resize_from<M>(std::move(*this)); }
+
+    template<typename U>
+    constexpr auto convert() const& { return convert_from<U>(*this); }
+    template<typename U>
+    constexpr auto convert() && { return convert_from<U>(std::move(*this)); }
+
+    // Перетворення до цілого U з округленням mode і насиченням до меж U (NaN -> 0)
+    template<typename U>
+    constexpr Vector<U, N> saturate_convert(Rounding mode = Rounding::nearest) const {
+        VECTOR_COUNT_CALL(instrumentation::Op::convert, N);
+        Vector<U, N> result;
+        if (N > detail::unroll_limit && !VECTOR_IS_CONSTANT_EVALUATED()) {
+            simd::saturate_convert(data(), result.data(), N, mode);
+        } else {
+            detail::static_for<0, N>([this, &result, mode](std::size_t i) {
+                result.at_unchecked(i) = saturate_cast<U>(data_[i], mode);
+            });
+        }
+        return result;
+    }
+
+    template<int StartIdx, int EndIdx>
+    constexpr auto slice() const& { return slice_from<StartIdx, EndIdx>(*this); }
+    template<int StartIdx, int EndIdx>
+    constexpr auto slice() && { return slice_from<StartIdx, EndIdx>(std::move(*this)); }
+
+    // Представлення без копіювання: O(1), дивиться на елементи цього вектора
+    constexpr VectorView<T, N> view() noexcept { return VectorView<T, N>(data()); }
+    constexpr VectorView<const T, N> view() const noexcept { return VectorView<const T, N>(data()); }
+
+    // Та сама семантика меж, що й у slice(), але без копіювання
+    template<int StartIdx, int EndIdx>
+    constexpr auto slice_view() noexcept { return make_slice_view<StartIdx, EndIdx>(data()); }
+    template<int StartIdx, int EndIdx>
+    constexpr auto slice_view() const noexcept { return make_slice_view<StartIdx, EndIdx>(data()); }
+
+    // M елементів від offset з кроком Stride; межі перевіряються під час виконання
+    template<std::size_t M, std::ptrdiff_t Stride = 1>
+    constexpr VectorView<T, M, Stride> view(std::size_t offset) {
+        detail::check_view_range(offset, M, Stride, N);
+        return VectorView<T, M, Stride>(data() + offset);
+    }
+    template<std::size_t M, std::ptrdiff_t Stride = 1>
+    constexpr VectorView<const T, M, Stride> view(std::size_t offset) const {
+        detail::check_view_range(offset, M, Stride, N);
+        return VectorView<const T, M, Stride>(data() + offset);
+    }
+
+    template<std::size_t M>
+    constexpr VectorView<T, M, dynamic_stride> strided_view(std::size_t offset, std::ptrdiff_t stride) {
+        detail::check_view_range(offset, M, stride, N);
+        return VectorView<T, M, dynamic_stride>(data() + offset, stride);
+    }
+    template<std::size_t M>
+    constexpr VectorView<const T, M, dynamic_stride> strided_view(std::size_t offset, std::ptrdiff_t stride) const {
+        detail::check_view_range(offset, M, stride, N);
+        return VectorView<const T, M, dynamic_stride>(data() + offset, stride);
+    }
+
+private:
+    alignas(Align) std::array<T, storage_size> data_;
+
+    template<std::size_t M, typename Self>
+    static constexpr auto resize_from(Self&& self) {
+        VECTOR_COUNT_CALL(instrumentation::Op::resize, M);
+        Vector<T, M> result;
+        constexpr std::size_t minN = (N < M ? N : M);
+        for (std::size_t i = 0; i < minN; ++i)
+            result.at_unchecked(i) = detail::forward_element<Self>(self, i);
+        return result;
+    }
+
+    template<typename U, typename Self>
+    static constexpr auto convert_from(Self&& self) {
+        VECTOR_COUNT_CALL(instrumentation::Op::convert, N);
+        Vector<U, N> result;
+        if constexpr (simd::has_conversion_v<T, U>) {
+            detail::convert_elements<N>(self.data(), result.data());
+        } else {
+            for (std::size_t i = 0; i < N; ++i)
+                result.at_unchecked(i) = static_cast<U>(detail::forward_element<Self>(self, i));
+        }
+        return result;
+    }
+
+    template<int StartIdx, int EndIdx, typename Self>
+    static constexpr auto slice_from(Self&& self) {
+        constexpr int s = (StartIdx < 0 ? static_cast<int>(N) + StartIdx : StartIdx);
+        constexpr int e = (EndIdx   < 0 ? static_cast<int>(N) + EndIdx   : EndIdx);
+        static_assert(s >= 0 && s < static_cast<int>(N), "slice start out of range");
+        static_assert(e >= 0 && e < static_cast<int>(N), "slice end out of range");
+        constexpr std::size_t len = (s <= e ? (e - s + 1) : (s - e + 1));
+        VECTOR_COUNT_CALL(instrumentation::Op::slice, len);
+        Vector<T, len> result;
+        if constexpr (s <= e) {
+            for (std::size_t i = 0; i < len; ++i)
+                result.at_unchecked(i) = detail::forward_element<Self>(self, s + i);
+        } else {
+            for (std::size_t i = 0; i < len; ++i)
+                result.at_unchecked(i) = detail::forward_element<Self>(self, s - i);
+        }
+        return result;
+    }
+
+    template<int StartIdx, int EndIdx, typename P>
+    static constexpr auto make_slice_view(P* first) noexcept {
+        constexpr int s = (StartIdx < 0 ? static_cast<int>(N) + StartIdx : StartIdx);
+        constexpr int e = (EndIdx   < 0 ? static_cast<int>(N) + EndIdx   : EndIdx);
+        static_assert(s >= 0 && s < static_cast<int>(N), "slice start out of range");
+        static_assert(e >= 0 && e < static_cast<int>(N), "slice end out of range");
+        constexpr std::size_t len = (s <= e ? (e - s + 1) : (s - e + 1));
+        return VectorView<P, len, (s <= e ? 1 : -1)>(first + s);
+    }
+
+    template<int I>
+    static constexpr std::size_t checked_static_index() noexcept {
+        constexpr std::size_t idx = detail::wrap_index(I, N);
+        static_assert(I < static_cast<int>(N) && I >= -static_cast<int>(N), "index out of range");
+        return idx;
+    }
+
+    template<typename E>
+    constexpr void assign_expression(const E& expr) { detail::evaluate_into<storage_size>(data_.data(), expr); }
+
+    template<typename U, typename Op>
+    constexpr Vector& apply_in_place(const U& rhs, Op op) {
+        if constexpr (!detail::contains_view_v<U>)
+            VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), N);
+        if constexpr (detail::contains_view_v<U>) {
+            return apply_in_place(Vector<typename std::decay_t<U>::value_type, N>(rhs), op);
+        } else if constexpr (is_vector_operand_v<U>) {
+            static_assert(std::decay_t<U>::dimension == N, "vector dimensions must match");
+            const auto apply = [this, &rhs, &op](std::size_t i) {
+                data_[i] = static_cast<T>(op(data_[i], detail::element(rhs, i)));
+            };
+            if constexpr (detail::packet_evaluable_v<U, T> && simd::supports_v<Op, T>) {
+                if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+                    using P = simd::Packet<T>;
+                    constexpr std::size_t bound = detail::packet_bound<T, N, std::min(storage_size, detail::storage_extent_v<U>)>();
+                    constexpr std::size_t full = bound - bound % P::width;
+                    for (std::size_t i = 0; i < full; i += P::width)
+                        P::store(data_.data() + i, simd::PacketOp<Op, T>::run(
+                            P::load(data_.data() + i), detail::packet_element<T>(rhs, i)));
+                    detail::static_for<std::min(full, N), N>(apply);
+                    return *this;
+                }
+            }
+            detail::static_for<0, N>(apply);
+        } else {
+            using S = detail::scalar_storage_t<T, U>;
+            const S s = static_cast<S>(rhs);
+            if constexpr (std::is_same_v<S, T> && simd::supports_v<Op, T> && N > detail::unroll_limit) {
+                if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+                    simd::transform_scalar(data_.data(), s, data_.data(), detail::packet_bound<T, N, storage_size>(), op);
+                    return *this;
+                }
+            }
+            detail::static_for<0, N>([this, s, &op](std::size_t i) { data_[i] = static_cast<T>(op(data_[i], s)); });
+        }
+        return *this;
+    }
+};
+
+// ---- Шаблони виразів: ліниві вузли для + - * / ----
+
+namespace detail {
+
+template<typename E>
+constexpr decltype(auto) element(const E& e, std::size_t i) {
+    if constexpr (is_vector_v<E>)
+        return e.data()[i];
+    else
+        return e.eval(i);
+}
+
+// Іменовані вектори зберігаються за посиланням, тимчасові та вузли - за значенням
+template<typename E>
+struct operand_storage {
+    using type = std::decay_t<E>;
+};
+
+template<typename E>
+struct operand_storage<E&> {
+    using type = std::conditional_t<is_vector_v<E>, const std::decay_t<E>&, std::decay_t<E>>;
+};
+
+template<typename E>
+using operand_storage_t = typename operand_storage<E>::type;
+
+template<typename T, typename E>
+auto packet_element(const E& e, std::size_t i) {
+    if constexpr (is_contiguous_v<E>)
+        return simd::Packet<T>::load(e.data() + i);
+    else
+        return e.packet(i);
+}
+
+template<typename CharT, typename Traits, typename E>
+void print_expression(std::basic_ostream<CharT, Traits>& os, const E& e) {
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    os << "[";
+    for (std::size_t i = 0; i < N; ++i) {
+        os << element(e, i) << (i + 1 < N ? ", " : "");
+    }
+    os << "]";
+}
+
+} // namespace detail
+
+template<typename Derived, typename R, std::size_t N>
+class VectorExpressionBase {
+public:
+    using value_type = R;
+    static constexpr std::size_t dimension = N;
+
+    constexpr std::size_t size() const noexcept { return N; }
+
+    constexpr R operator[](int index) const { return self().eval(detail::access_index(index, N)); }
+    constexpr R at(int index) const { return self().eval(detail::normalize_index(index, N)); }
+
+    constexpr Vector<R, N> evaluate() const { return Vector<R, N>(self()); }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const Derived& e) {
+        detail::print_expression(os, e);
+        return os;
+    }
+
+private:
+    constexpr const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+template<typename Op, typename L, typename R>
+class VectorBinaryExpression
+    : public VectorExpressionBase<VectorBinaryExpression<Op, L, R>,
+                                  Promote<typename std::decay_t<L>::value_type,
+                                          typename std::decay_t<R>::value_type>,
+                                  std::decay_t<L>::dimension> {
+public:
+    using value_type = Promote<typename std::decay_t<L>::value_type, typename std::decay_t<R>::value_type>;
+    static_assert(std::decay_t<L>::dimension == std::decay_t<R>::dimension,
+                  "vector dimensions must match");
+
+    template<typename LA, typename RA>
+    constexpr VectorBinaryExpression(LA&& lhs, RA&& rhs)
+        : lhs_(std::forward<LA>(lhs)), rhs_(std::forward<RA>(rhs)) {}
+
+    constexpr value_type eval(std::size_t i) const {
+        return static_cast<value_type>(Op{}(detail::element(lhs_, i), detail::element(rhs_, i)));
+    }
+
+    auto packet(std::size_t i) const {
+        return simd::PacketOp<Op, value_type>::run(detail::packet_element<value_type>(lhs_, i),
+                                                   detail::packet_element<value_type>(rhs_, i));
+    }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+template<typename Op, typename L, typename S>
+class VectorScalarExpression
+    : public VectorExpressionBase<VectorScalarExpression<Op, L, S>,
+                                  Promote<typename std::decay_t<L>::value_type, S>,
+                                  std::decay_t<L>::dimension> {
+public:
+    using value_type = Promote<typename std::decay_t<L>::value_type, S>;
+
+    template<typename LA, typename SA>
+    constexpr VectorScalarExpression(LA&& lhs, SA&& scalar)
+        : lhs_(std::forward<LA>(lhs)), scalar_(std::forward<SA>(scalar)) {}
+
+    constexpr value_type eval(std::size_t i) const {
+        return static_cast<value_type>(Op{}(detail::element(lhs_, i), scalar_));
+    }
+
+    auto packet(std::size_t i) const {
+        return simd::PacketOp<Op, value_type>::run(detail::packet_element<value_type>(lhs_, i),
+                                                   simd::Packet<value_type>::broadcast(scalar_));
+    }
+
+private:
+    L lhs_;
+    S scalar_;
+};
+
+template<typename Op, typename L, typename R>
+struct is_vector_expression<VectorBinaryExpression<Op, L, R>> : std::true_type {};
+
+template<typename Op, typename L, typename S>
+struct is_vector_expression<VectorScalarExpression<Op, L, S>> : std::true_type {};
+
+// ---- VectorView: невласницьке представлення з кроком ----
+
+// Елемент i лежить за адресою data() + i * stride(); від'ємний крок іде у зворотному
+// порядку, як у slice<Start, End>() зі Start > End. Для T = const U - лише читання.
+template<typename T, std::size_t N, std::ptrdiff_t Stride>
+class VectorView {
+public:
+    using value_type = std::remove_const_t<T>;
+    static constexpr std::size_t dimension = N;
+    static constexpr std::ptrdiff_t static_stride = Stride;
+
+    template<std::ptrdiff_t S = Stride, std::enable_if_t<S != dynamic_stride, int> = 0>
+    constexpr explicit VectorView(T* first) noexcept : first_(first), stride_(Stride) {}
+
+    template<std::ptrdiff_t S = Stride, std::enable_if_t<S == dynamic_stride, int> = 0>
+    constexpr VectorView(T* first, std::ptrdiff_t stride) noexcept : first_(first), stride_(stride) {}
+
+    constexpr VectorView(const VectorView&) = default;
+
+    template<typename U, std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>, int> = 0>
+    constexpr VectorView(const VectorView<U, N, Stride>& other) noexcept
+        : first_(other.data()), stride_(other.stride()) {}
+
+    // Присвоєння копіює елементи, а не перенаправляє представлення
+    constexpr VectorView& operator=(const VectorView& other) {
+        assign(other);
+        return *this;
+    }
+
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    constexpr VectorView& operator=(const E& e) {
+        assign(e);
+        return *this;
+    }
+
+    constexpr T& operator[](int index) const { return first_[offset(detail::access_index(index, N))]; }
+    constexpr T& at(int index) const { return first_[offset(detail::normalize_index(index, N))]; }
+    constexpr Expected<std::remove_const_t<T>> try_at(int index) const {
+        if (!detail::index_in_range(index, N))
+            return detail::unexpected_error(VectorError{VectorErrc::out_of_range, index, N});
+        return first_[offset(detail::wrap_index(index, N))];
+    }
+    constexpr T& at_unchecked(std::size_t index) const noexcept { return first_[offset(index)]; }
+    constexpr value_type eval(std::size_t index) const noexcept { return first_[offset(index)]; }
+
+    constexpr std::size_t size() const noexcept { return N; }
+    constexpr T* data() const noexcept { return first_; }
+    constexpr std::ptrdiff_t stride() const noexcept { return Stride == dynamic_stride ? stride_ : Stride; }
+
+    constexpr Vector<value_type, N> to_vector() const { return Vector<value_type, N>(*this); }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const VectorView& v) {
+        detail::print_expression(os, v);
+        return os;
+    }
+
+private:
+    T* first_;
+    std::ptrdiff_t stride_;
+
+    constexpr std::ptrdiff_t offset(std::size_t i) const noexcept {
+        return static_cast<std::ptrdiff_t>(i) * stride();
+    }
+
+    template<typename E>
+    constexpr void assign(const E& e) {
+        static_assert(!std::is_const_v<T>, "view of const elements is read-only");
+        const Vector<value_type, N> tmp(e);
+        for (std::size_t i = 0; i < N; ++i)
+            first_[offset(i)] = tmp.at_unchecked(i);
+    }
+};
+
+template<typename T, std::size_t N, std::ptrdiff_t Stride>
+struct is_vector_expression<VectorView<T, N, Stride>> : std::true_type {};
+
+namespace detail {
+
+template<typename T, std::size_t N, typename P>
+struct packet_evaluable<VectorView<T, N, 1>, P>
+    : std::bool_constant<std::is_same_v<std::remove_const_t<T>, P> && simd::Packet<P>::enabled> {};
+
+template<typename Op, typename L, typename R>
+struct contains_view<VectorBinaryExpression<Op, L, R>>
+    : std::bool_constant<contains_view_v<L> || contains_view_v<R>> {};
+
+template<typename Op, typename L, typename S>
+struct contains_view<VectorScalarExpression<Op, L, S>> : std::bool_constant<contains_view_v<L>> {};
+
+template<typename Op, typename L, typename R>
+struct storage_extent<VectorBinaryExpression<Op, L, R>>
+    : std::integral_constant<std::size_t, std::min(storage_extent_v<L>, storage_extent_v<R>)> {};
+
+template<typename Op, typename L, typename S>
+struct storage_extent<VectorScalarExpression<Op, L, S>> : std::integral_constant<std::size_t, storage_extent_v<L>> {};
+
+template<typename Op, typename L, typename R, typename T>
+struct packet_evaluable<VectorBinaryExpression<Op, L, R>, T>
+    : std::bool_constant<std::is_same_v<typename VectorBinaryExpression<Op, L, R>::value_type, T> &&
+                         simd::supports_v<Op, T> &&
+                         packet_evaluable_v<L, T> && packet_evaluable_v<R, T>> {};
+
+template<typename Op, typename L, typename S, typename T>
+struct packet_evaluable<VectorScalarExpression<Op, L, S>, T>
+    : std::bool_constant<std::is_same_v<S, T> &&
+                         std::is_same_v<typename VectorScalarExpression<Op, L, S>::value_type, T> &&
+                         simd::supports_v<Op, T> && packet_evaluable_v<L, T>> {};
+
+// Один злитий прохід: повні пакети, потім скалярний хвіст. out має місце для
+// Extent елементів; якщо доповнення виразу і out вміщує останній пакет, хвоста немає.
+// Короткий хвіст і малі вектори цілком розгортаються (static_for)
+template<std::size_t Extent, typename T, typename E>
+constexpr void evaluate_into(T* out, const E& expr) {
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    const auto assign = [out, &expr](std::size_t i) { out[i] = static_cast<T>(expr.eval(i)); };
+    if constexpr (packet_evaluable_v<E, T>) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+            using P = simd::Packet<T>;
+            constexpr std::size_t bound = packet_bound<T, N, std::min(Extent, storage_extent_v<E>)>();
+            constexpr std::size_t full = bound - bound % P::width;
+            for (std::size_t i = 0; i < full; i += P::width)
+                P::store(out + i, packet_element<T>(expr, i));
+            static_for<std::min(full, N), N>(assign);
+            return;
+        }
+    }
+    static_for<0, N>(assign);
+}
+
+} // namespace detail
+
+template<typename E, std::enable_if_t<is_vector_expression_v<E>, int> = 0>
+Vector(const E&) -> Vector<typename std::decay_t<E>::value_type, std::decay_t<E>::dimension>;
+
+namespace detail {
+
+template<typename Op, typename L, typename R>
+constexpr auto make_expression(L&& lhs, R&& rhs) {
+    using LT = typename std::decay_t<L>::value_type;
+    VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), std::decay_t<L>::dimension);
+    if constexpr (is_vector_operand_v<R>) {
+        static_assert(std::decay_t<L>::dimension == std::decay_t<R>::dimension,
+                      "vector dimensions must match");
+        using Node = VectorBinaryExpression<Op, operand_storage_t<L>, operand_storage_t<R>>;
+        VECTOR_COUNT_PROMOTION_IF((!std::is_same_v<typename Node::value_type, LT> ||
+                                   !std::is_same_v<typename Node::value_type, typename std::decay_t<R>::value_type>));
+        return Node(std::forward<L>(lhs), std::forward<R>(rhs));
+    } else {
+        using S = scalar_storage_t<LT, R>;
+        using Node = VectorScalarExpression<Op, operand_storage_t<L>, S>;
+        VECTOR_COUNT_PROMOTION_IF((!std::is_same_v<typename Node::value_type, LT>));
+        return Node(std::forward<L>(lhs), static_cast<S>(std::forward<R>(rhs)));
+    }
+}
+
+} // namespace detail
+
+template<typename L, typename R, std::enable_if_t<is_vector_operand_v<L> && !is_sparse_vector_v<R>, int> = 0>
+constexpr auto operator+(L&& lhs, R&& rhs) {
+    return detail::make_expression<std::plus<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, std::enable_if_t<is_vector_operand_v<L> && !is_sparse_vector_v<R>, int> = 0>
+constexpr auto operator-(L&& lhs, R&& rhs) {
+    return detail::make_expression<std::minus<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, std::enable_if_t<is_vector_operand_v<L> && !is_sparse_vector_v<R>, int> = 0>
+constexpr auto operator*(L&& lhs, R&& rhs) {
+    return detail::make_expression<std::multiplies<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename L, typename R, std::enable_if_t<is_vector_operand_v<L> && !is_sparse_vector_v<R>, int> = 0>
+constexpr auto operator/(L&& lhs, R&& rhs) {
+    return detail::make_expression<std::divides<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template<typename T1, std::size_t N, std::size_t A1, typename U1, typename T2, std::size_t A2, typename U2>
+constexpr auto weighted_sum(const Vector<T1, N, A1>& v1,
+                  const U1& alpha,
+                  const Vector<T2, N, A2>& v2,
+                  const U2& beta) {
+    using R1 = std::common_type_t<T1, U1>;
+    using R2 = std::common_type_t<T2, U2>;
+    using R  = typename PromoteMultiple<R1, R2>::type;
+    VECTOR_COUNT_CALL(instrumentation::Op::weighted_sum, N);
+    VECTOR_COUNT_PROMOTION_IF((!std::is_same_v<T1, R> || !std::is_same_v<T2, R>));
+    Vector<R, N> result;
+    if constexpr (std::is_same_v<T1, R> && std::is_same_v<T2, R> &&
+                  std::is_arithmetic_v<U1> && std::is_arithmetic_v<U2>) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+            simd::axpby(static_cast<R>(alpha), v1.data(), static_cast<R>(beta), v2.data(), result.data(), N);
+            return result;
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i)
+        result.at_unchecked(i) = alpha * v1.at_unchecked(i) + beta * v2.at_unchecked(i);
+    return result;
+}
+
+namespace detail {
+
+// a * b + c; на етапі компіляції - без std::fma, яка не constexpr
+template<typename T>
+constexpr T fused_mul_add(T a, T b, T c) {
+    if (!VECTOR_IS_CONSTANT_EVALUATED())
+        return simd::mul_add(a, b, c);
+    return static_cast<T>(a * b + c);
+}
+
+template<typename Tuple, std::size_t... I>
+constexpr auto linear_combination_impl(const Tuple& args, std::index_sequence<I...>) {
+    using Types = std::decay_t<Tuple>;
+    constexpr std::size_t K = sizeof...(I);
+    constexpr std::size_t N = std::decay_t<std::tuple_element_t<0, Types>>::dimension;
+    static_assert(((std::decay_t<std::tuple_element_t<2 * I, Types>>::dimension == N) && ...),
+                  "vector dimensions must match");
+    using R = typename PromoteMultiple<typename std::decay_t<std::tuple_element_t<2 * I, Types>>::value_type...,
+                                       std::decay_t<std::tuple_element_t<2 * I + 1, Types>>...>::type;
+    VECTOR_COUNT_CALL(instrumentation::Op::weighted_sum, N * K);
+    Vector<R, N> result;
+    if constexpr (((is_contiguous_v<std::tuple_element_t<2 * I, Types>> && !contains_view_v<std::tuple_element_t<2 * I, Types>> &&
+                    std::is_same_v<typename std::decay_t<std::tuple_element_t<2 * I, Types>>::value_type, R> &&
+                    std::is_arithmetic_v<std::decay_t<std::tuple_element_t<2 * I + 1, Types>>>) && ...)) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+            simd::linear_combination<R, K>({std::get<2 * I>(args).data()...},
+                                           {static_cast<R>(std::get<2 * I + 1>(args))...}, result.data(), N);
+            return result;
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        R acc{};
+        ((acc = (I == 0)
+              ? static_cast<R>(static_cast<R>(std::get<1>(args)) * static_cast<R>(element(std::get<0>(args), i)))
+              : fused_mul_add(static_cast<R>(std::get<2 * I + 1>(args)),
+                              static_cast<R>(element(std::get<2 * I>(args), i)), acc)), ...);
+        result.at_unchecked(i) = acc;
+    }
+    return result;
+}
+
+} // namespace detail
+
+// linear_combination(v1, a1, v2, a2, ..., vk, ak) = a1 * v1 + ... + ak * vk одним проходом;
+// тип результату - PromoteMultiple усіх типів елементів і коефіцієнтів.
+// Для дійсних типів множення з додаванням злиті, якщо є апаратна FMA.
+template<typename V, typename... Args, std::enable_if_t<is_vector_operand_v<V>, int> = 0>
+constexpr auto linear_combination(const V& first, const Args&... rest) {
+    static_assert(sizeof...(Args) % 2 == 1, "linear_combination expects (vector, coefficient) pairs");
+    return detail::linear_combination_impl(std::forward_as_tuple(first, rest...),
+                                           std::make_index_sequence<(sizeof...(Args) + 1) / 2>{});
+}
+
+// acc = acc + alpha * x на місці; семантика weighted_sum(acc, 1, x, alpha), результат у типі acc
+template<typename T, std::size_t N, std::size_t A, typename U, typename E,
+         std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr Vector<T, N, A>& axpy(Vector<T, N, A>& acc, const U& alpha, const E& x) {
+    static_assert(std::decay_t<E>::dimension == N, "vector dimensions must match");
+    VECTOR_COUNT_CALL(instrumentation::Op::axpy, N);
+    if constexpr (detail::is_contiguous_v<E> && !detail::contains_view_v<E> &&
+                  std::is_same_v<typename std::decay_t<E>::value_type, T> &&
+                  std::is_arithmetic_v<T> && std::is_arithmetic_v<U> && std::is_same_v<Promote<T, U>, T>) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+            simd::axpy(static_cast<T>(alpha), x.data(), acc.data(), N);
+            return acc;
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i)
+        acc.at_unchecked(i) = static_cast<T>(acc.at_unchecked(i) + alpha * detail::element(x, i));
+    return acc;
+}
+
+// Тимчасові вектори-аргументи віддають свої елементи переміщенням
+template<typename V1, typename V2, std::enable_if_t<is_vector_v<V1> && is_vector_v<V2>, int> = 0>
+constexpr auto concat(V1&& v1, V2&& v2) {
+    using T1 = typename std::decay_t<V1>::value_type;
+    using T2 = typename std::decay_t<V2>::value_type;
+    constexpr std::size_t N1 = std::decay_t<V1>::dimension;
+    constexpr std::size_t N2 = std::decay_t<V2>::dimension;
+    using R = typename PromoteMultiple<T1, T2>::type;
+    constexpr std::size_t M = N1 + N2;
+    VECTOR_COUNT_CALL(instrumentation::Op::concat, M);
+    Vector<R, M> result;
+    for (std::size_t i = 0; i < N1; ++i) result.at_unchecked(i) = detail::forward_element<V1>(v1, i);
+    for (std::size_t j = 0; j < N2; ++j) result.at_unchecked(N1 + j) = detail::forward_element<V2>(v2, j);
+    return result;
+}
+
+template<typename V, typename... Vs>
+constexpr auto concat(V&& first, Vs&&... rest) {
+    constexpr std::size_t total = (std::decay_t<V>::dimension + ... + std::decay_t<Vs>::dimension);
+    using R = typename PromoteMultiple<typename std::decay_t<V>::value_type,
+                                       typename std::decay_t<Vs>::value_type...>::type;
+    VECTOR_COUNT_CALL(instrumentation::Op::concat, total);
+    Vector<R, total> result;
+    std::size_t pos = 0;
+    auto append = [&](auto&& vec) {
+        using Src = decltype(vec);
+        for (std::size_t i = 0; i < std::decay_t<Src>::dimension; ++i)
+            result.at_unchecked(pos++) = detail::forward_element<Src>(vec, i);
+    };
+    (append(std::forward<V>(first)), ..., append(std::forward<Vs>(rest)));
+    return result;
+}
+
+template<typename T, typename... Args>
+constexpr auto make_vector(Args&&... args) {
+    constexpr std::size_t N = sizeof...(Args);
+    Vector<T, N> result;
+    std::size_t i = 0;
+    ((result.at_unchecked(i++) = static_cast<T>(std::forward<Args>(args))), ...);
+    return result;
+}
+
+template<typename... Args>
+constexpr auto build_vector(Args&&... args) {
+    using U = std::common_type_t<Args...>;
+    constexpr std::size_t N = sizeof...(Args);
+    Vector<U, N> result;
+    std::size_t i = 0;
+    ((result.at_unchecked(i++) = static_cast<U>(std::forward<Args>(args))), ...);
+    return result;
+}
+
+// ---- Згортки: dot, sum, norm, squared_norm, min, max, argmin, argmax ----
+
+// fast - кілька акумуляторів і SIMD, pairwise - попарне додавання,
+// kahan - компенсоване додавання (для цілих типів усі режими однакові)
+enum class Summation {
+    fast,
+    pairwise,
+    kahan
+};
+
+namespace detail {
+
+template<typename R, typename F, std::size_t... I>
+constexpr R unrolled_sum(const F& f, std::index_sequence<I...>) {
+    return (R{} + ... + f(I));
+}
+
+template<typename R, typename F>
+constexpr R multi_accumulator_sum(const F& f, std::size_t n) {
+    R a0{}, a1{}, a2{}, a3{};
+    std::size_t i = 0;
+    for (const std::size_t full = n - n % 4; i < full; i += 4) {
+        a0 += f(i);
+        a1 += f(i + 1);
+        a2 += f(i + 2);
+        a3 += f(i + 3);
+    }
+    for (; i < n; ++i)
+        a0 += f(i);
+    return (a0 + a1) + (a2 + a3);
+}
+
+template<typename R, typename F>
+constexpr R pairwise_sum(const F& f, std::size_t begin, std::size_t end) {
+    if (end - begin <= 8) {
+        R s{};
+        for (std::size_t i = begin; i < end; ++i)
+            s += f(i);
+        return s;
+    }
+    const std::size_t mid = begin + (end - begin) / 2;
+    return pairwise_sum<R>(f, begin, mid) + pairwise_sum<R>(f, mid, end);
+}
+
+template<typename R, typename F>
+constexpr R kahan_sum(const F& f, std::size_t n) {
+    R s{}, c{};
+    for (std::size_t i = 0; i < n; ++i) {
+        const R y = f(i) - c;
+        const R t = s + y;
+        c = (t - s) - y;
+        s = t;
+    }
+    return s;
+}
+
+// f(i) повертає i-й доданок типу R
+template<typename R, std::size_t N, typename F>
+constexpr R reduce_sum(const F& f, Summation mode) {
+    if constexpr (std::is_floating_point_v<R>) {
+        if (mode == Summation::kahan)
+            return kahan_sum<R>(f, N);
+        if (mode == Summation::pairwise)
+            return pairwise_sum<R>(f, 0, N);
+    }
+    if constexpr (N <= 8)
+        return unrolled_sum<R>(f, std::make_index_sequence<N>{});
+    else
+        return multi_accumulator_sum<R>(f, N);
+}
+
+template<typename T, std::size_t N>
+constexpr bool use_packet_reduction = simd::Packet<T>::enabled && N >= 2 * simd::Packet<T>::width;
+
+template<typename R>
+using norm_result_t = std::conditional_t<std::is_floating_point_v<R>, R, double>;
+
+} // namespace detail
+
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr auto sum(const E& v, Summation mode = Summation::fast) {
+    using T = typename std::decay_t<E>::value_type;
+    using R = Promote<T, T>;
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, N);
+    if constexpr (detail::is_contiguous_v<E> && std::is_same_v<T, R> && detail::use_packet_reduction<T, N>) {
+        if (mode == Summation::fast && !VECTOR_IS_CONSTANT_EVALUATED())
+            return simd::sum(v.data(), N);
+    }
+    return detail::reduce_sum<R, N>([&v](std::size_t i) { return static_cast<R>(detail::element(v, i)); }, mode);
+}
+
+template<typename A, typename B,
+         std::enable_if_t<is_vector_operand_v<A> && is_vector_operand_v<B>, int> = 0>
+constexpr auto dot(const A& a, const B& b, Summation mode = Summation::fast) {
+    using TA = typename std::decay_t<A>::value_type;
+    using TB = typename std::decay_t<B>::value_type;
+    using R = Promote<TA, TB>;
+    constexpr std::size_t N = std::decay_t<A>::dimension;
+    static_assert(N == std::decay_t<B>::dimension, "vector dimensions must match");
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, N);
+    if constexpr (detail::is_contiguous_v<A> && detail::is_contiguous_v<B> &&
+                  std::is_same_v<TA, R> && std::is_same_v<TB, R> &&
+                  detail::use_packet_reduction<R, N> && simd::Packet<R>::has_mul) {
+        if (mode == Summation::fast && !VECTOR_IS_CONSTANT_EVALUATED())
+            return simd::dot(a.data(), b.data(), N);
+    }
+    return detail::reduce_sum<R, N>(
+        [&a, &b](std::size_t i) { return static_cast<R>(detail::element(a, i) * detail::element(b, i)); }, mode);
+}
+
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr auto squared_norm(const E& v, Summation mode = Summation::fast) {
+    return dot(v, v, mode);
+}
+
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto norm(const E& v, Summation mode = Summation::fast) {
+    using F = detail::norm_result_t<decltype(squared_norm(v, mode))>;
+    return static_cast<F>(std::sqrt(static_cast<F>(squared_norm(v, mode))));
+}
+
+// Векторний добуток для N == 3; для N == 2 - його z-компонента (a.x * b.y - a.y * b.x)
+template<typename A, typename B,
+         std::enable_if_t<is_vector_operand_v<A> && is_vector_operand_v<B>, int> = 0>
+constexpr auto cross(const A& a, const B& b) {
+    using R = Promote<typename std::decay_t<A>::value_type, typename std::decay_t<B>::value_type>;
+    constexpr std::size_t N = std::decay_t<A>::dimension;
+    static_assert(N == std::decay_t<B>::dimension, "vector dimensions must match");
+    static_assert(N == 2 || N == 3, "cross is defined for 2D and 3D vectors");
+    const auto e = [](const auto& v, std::size_t i) { return static_cast<R>(detail::element(v, i)); };
+    if constexpr (N == 2) {
+        return static_cast<R>(e(a, 0) * e(b, 1) - e(a, 1) * e(b, 0));
+    } else {
+        return make_vector<R>(e(a, 1) * e(b, 2) - e(a, 2) * e(b, 1),
+                              e(a, 2) * e(b, 0) - e(a, 0) * e(b, 2),
+                              e(a, 0) * e(b, 1) - e(a, 1) * e(b, 0));
+    }
+}
+
+// Одиничний вектор того ж напрямку; цілі компоненти дають double, нульовий вектор лишається нульовим
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto normalize(const E& v, Summation mode = Summation::fast) {
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    using F = detail::norm_result_t<decltype(squared_norm(v, mode))>;
+    const F len = norm(v, mode);
+    const F inv = len > F(0) ? F(1) / len : F(0);
+    Vector<F, N> result;
+    detail::static_for<0, N>([&result, &v, inv](std::size_t i) {
+        result.at_unchecked(i) = static_cast<F>(detail::element(v, i)) * inv;
+    });
+    return result;
+}
+
+// ---- Політики точності: divide() і normalize() з тегом PreciseMath, ReciprocalMath або ApproxMath<S> ----
+
+// Політика - тег виклику, тож точний і швидкий код співіснують в одній збірці. Похибки
+// відносні, u - одиниця округлення (2^-24 для float, 2^-53 для double):
+//   PreciseMath    - ділення чи sqrt на кожен елемент, коректне округлення (0.5 ulp);
+//   ReciprocalMath - v / s як v * (1 / s): одне ділення на вектор, до 2u (не більше 2 ulp);
+//                    поелементне a / b лишається точним;
+//   ApproxMath<S>  - як ReciprocalMath для скаляра, а a / b і normalize беруть апаратну оцінку
+//                    rcp / rsqrt і S кроків Ньютона-Рафсона. Похибка оцінки e0: SSE/AVX
+//                    1.5 * 2^-12, AVX-512 2^-14, NEON близько 2^-8; крок дає приблизно
+//                    e0^2 + 2u. Заміряно для float: SSE/AVX S = 0 - до 2^-11, S = 1 - до 3 ulp,
+//                    S = 2 - до 2 ulp; AVX-512 S = 0 - 2^-14, S = 1 - до 1.5 ulp; для double
+//                    (AVX-512) S = 1 - 2^-28, S = 2 - 1 ulp. Нульові, нескінченні й денормальні
+//                    дільники дають inf чи NaN замість результатів IEEE. Без оцінки (double
+//                    без AVX-512, скалярна збірка) - точне ділення.
+// Цілі типи результату завжди діляться точно. Для normalize додається похибка squared_norm.
+// Чи вигідна ApproxMath, залежить від процесора (на нових ядрах divps швидкий) - див. --bench.
+struct PreciseMath {};
+struct ReciprocalMath {};
+
+template<unsigned Steps = 1>
+struct ApproxMath {
+    static constexpr unsigned steps = Steps;
+};
+
+namespace detail {
+
+template<typename P>
+struct is_math_policy : std::bool_constant<std::is_same_v<P, PreciseMath> || std::is_same_v<P, ReciprocalMath>> {};
+
+template<unsigned S>
+struct is_math_policy<ApproxMath<S>> : std::true_type {};
+
+template<typename P>
+struct is_approx_math : std::false_type {};
+
+template<unsigned S>
+struct is_approx_math<ApproxMath<S>> : std::true_type {};
+
+// Операнд як неперервний масив типу R: сам операнд або його копія
+template<typename R, typename E>
+decltype(auto) as_contiguous(const E& e) {
+    if constexpr (is_contiguous_v<E> && std::is_same_v<std::remove_const_t<typename std::decay_t<E>::value_type>, R>)
+        return (e);
+    else
+        return Vector<R, std::decay_t<E>::dimension>(e);
+}
+
+} // namespace detail
+
+template<typename E, typename U, typename Policy,
+         std::enable_if_t<is_vector_operand_v<E> && std::is_arithmetic_v<U> && detail::is_math_policy<Policy>::value, int> = 0>
+auto divide(const E& v, const U& scalar, Policy) {
+    using R = Promote<typename std::decay_t<E>::value_type, U>;
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    if constexpr (std::is_same_v<Policy, PreciseMath> || !std::is_floating_point_v<R>) {
+        return Vector<R, N>(v / scalar);
+    } else {
+        const R inv = R(1) / static_cast<R>(scalar);
+        return Vector<R, N>(v * inv);
+    }
+}
+
+template<typename A, typename B, typename Policy,
+         std::enable_if_t<is_vector_operand_v<A> && is_vector_operand_v<B> && detail::is_math_policy<Policy>::value, int> = 0>
+auto divide(const A& a, const B& b, Policy) {
+    using R = Promote<typename std::decay_t<A>::value_type, typename std::decay_t<B>::value_type>;
+    constexpr std::size_t N = std::decay_t<A>::dimension;
+    static_assert(N == std::decay_t<B>::dimension, "vector dimensions must match");
+    if constexpr (detail::is_approx_math<Policy>::value && simd::has_estimate_v<R>) {
+        VECTOR_COUNT_CALL(instrumentation::Op::div, N);
+        const auto& x = detail::as_contiguous<R>(a);
+        const auto& y = detail::as_contiguous<R>(b);
+        Vector<R, N> result;
+        simd::divide_approx<Policy::steps>(x.data(), y.data(), result.data(), N);
+        return result;
+    } else {
+        return Vector<R, N>(a / b);
+    }
+}
+
+// normalize з політикою: PreciseMath ділить кожен елемент на довжину, ReciprocalMath множить
+// на 1 / довжину (як normalize(v)), ApproxMath<S> бере 1 / sqrt з rsqrt і S кроків
+template<typename E, typename Policy,
+         std::enable_if_t<is_vector_operand_v<E> && detail::is_math_policy<Policy>::value, int> = 0>
+auto normalize(const E& v, Policy) {
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    using F = detail::norm_result_t<decltype(squared_norm(v))>;
+    const F s = static_cast<F>(squared_norm(v));
+    Vector<F, N> result;
+    if (!(s > F(0)))
+        return result;
+    if constexpr (std::is_same_v<Policy, PreciseMath>) {
+        const F len = std::sqrt(s);
+        detail::static_for<0, N>([&result, &v, len](std::size_t i) {
+            result.at_unchecked(i) = static_cast<F>(detail::element(v, i)) / len;
+        });
+    } else {
+        F inv;
+        if constexpr (detail::is_approx_math<Policy>::value)
+            inv = simd::reciprocal_sqrt<Policy::steps>(s);
+        else
+            inv = F(1) / std::sqrt(s);
+        detail::static_for<0, N>([&result, &v, inv](std::size_t i) {
+            result.at_unchecked(i) = static_cast<F>(detail::element(v, i)) * inv;
+        });
+    }
+    return result;
+}
+
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr auto min(const E& v) {
+    using T = typename std::decay_t<E>::value_type;
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    static_assert(N > 0, "min of an empty vector");
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, N);
+    if constexpr (detail::is_contiguous_v<E> && detail::use_packet_reduction<T, N> && simd::Packet<T>::has_minmax) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED())
+            return simd::min(v.data(), N);
+    }
+    T r = detail::element(v, 0);
+    for (std::size_t i = 1; i < N; ++i) {
+        const T x = detail::element(v, i);
+        if (x < r)
+            r = x;
+    }
+    return r;
+}
+
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr auto max(const E& v) {
+    using T = typename std::decay_t<E>::value_type;
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    static_assert(N > 0, "max of an empty vector");
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, N);
+    if constexpr (detail::is_contiguous_v<E> && detail::use_packet_reduction<T, N> && simd::Packet<T>::has_minmax) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED())
+            return simd::max(v.data(), N);
+    }
+    T r = detail::element(v, 0);
+    for (std::size_t i = 1; i < N; ++i) {
+        const T x = detail::element(v, i);
+        if (r < x)
+            r = x;
+    }
+    return r;
+}
+
+// Індекс першого найменшого / найбільшого елемента
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr std::size_t argmin(const E& v) {
+    using T = typename std::decay_t<E>::value_type;
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    static_assert(N > 0, "argmin of an empty vector");
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, N);
+    std::size_t best = 0;
+    T r = detail::element(v, 0);
+    for (std::size_t i = 1; i < N; ++i) {
+        const T x = detail::element(v, i);
+        if (x < r) {
+            r = x;
+            best = i;
+        }
+    }
+    return best;
+}
+
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+constexpr std::size_t argmax(const E& v) {
+    using T = typename std::decay_t<E>::value_type;
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    static_assert(N > 0, "argmax of an empty vector");
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, N);
+    std::size_t best = 0;
+    T r = detail::element(v, 0);
+    for (std::size_t i = 1; i < N; ++i) {
+        const T x = detail::element(v, i);
+        if (r < x) {
+            r = x;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// ---- Попередньо скомпільовані інстанціації (vector_instantiations.cpp) ----
+
+// З -DVECTOR_EXTERN_TEMPLATES=1 поширені типи тут лише оголошуються, а їхній код береться
+// з vector_instantiations.o. Прапорці (-std, -march, VECTOR_*) мають збігатися з бібліотечними.
+#ifndef VECTOR_EXTERN_TEMPLATES
+#  define VECTOR_EXTERN_TEMPLATES 0
+#endif
+
+// X(T, N) для кожної пари тип x розмір, яку бібліотека інстанціює заздалегідь
+#define VECTOR_INSTANCE_SIZES(X, T) X(T, 2) X(T, 3) X(T, 4) X(T, 8) X(T, 16)
+#define VECTOR_FOR_EACH_INSTANCE(X) \
+    VECTOR_INSTANCE_SIZES(X, float) VECTOR_INSTANCE_SIZES(X, double) VECTOR_INSTANCE_SIZES(X, int)
+#define VECTOR_FOR_EACH_INSTANCE_TYPE(X) X(float) X(double) X(int)
+
+#if VECTOR_EXTERN_TEMPLATES
+#  define VECTOR_EXTERN_VECTOR(T, N) extern template class Vector<T, N>;
+VECTOR_FOR_EACH_INSTANCE(VECTOR_EXTERN_VECTOR)
+#  undef VECTOR_EXTERN_VECTOR
+#endif
@@ -0,0 +1,14 @@
+// Уся бібліотека одним заголовком
+#pragma once
+
+#include "vector.hpp"
+#include "vector_dispatch.hpp"
+#include "vector_batch.hpp"
+#include "vector_dyn.hpp"
+#include "vector_matrix.hpp"
+#include "vector_io.hpp"
+#include "vector_parallel.hpp"
+#include "vector_pipeline.hpp"
+#include "vector_knn.hpp"
+#include "vector_sparse.hpp"
+#include "vector_gpu.hpp"
@@ -0,0 +1,402 @@
+// VectorBatch: структура масивів і вирівняний алокатор
+#pragma once
+
+#include "vector_dispatch.hpp"
+#include <memory>
+#include <new>
+
+// ---- VectorBatch: структура масивів для великої кількості малих векторів ----
+
+// Алокатор з вирівнюванням блоку пам'яті на Align байтів
+template<typename T, std::size_t Align = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+    static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T), "invalid alignment");
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Align});
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+};
+
+// Контейнер векторів, що починається з межі кеш-лінії (або строгішої alignof(V)).
+// Вектор для кожного потоку варто брати з alignment = 64, щоб уникнути хибного спільного доступу.
+template<typename V, std::size_t Align = 64>
+using AlignedVectorArray = std::vector<V, AlignedAllocator<V, (alignof(V) > Align ? alignof(V) : Align)>>;
+
+template<typename T, std::size_t N>
+class VectorBatch;
+
+template<typename T>
+struct is_vector_batch : std::false_type {};
+
+template<typename T, std::size_t N>
+struct is_vector_batch<VectorBatch<T, N>> : std::true_type {};
+
+template<typename T>
+constexpr bool is_vector_batch_v = is_vector_batch<std::decay_t<T>>::value;
+
+// Рядок пакета без копіювання: поводиться як Vector<T, N> і бере участь у виразах.
+// Для const T рядок доступний лише для читання.
+template<typename T, std::size_t N>
+class VectorBatchRow {
+public:
+    using value_type = std::remove_const_t<T>;
+    static constexpr std::size_t dimension = N;
+    using batch_type = std::conditional_t<std::is_const_v<T>,
+                                          const VectorBatch<value_type, N>,
+                                          VectorBatch<value_type, N>>;
+
+    VectorBatchRow(batch_type& batch, std::size_t row) noexcept : batch_(&batch), row_(row) {}
+    VectorBatchRow(const VectorBatchRow&) = default;
+
+    const VectorBatchRow& operator=(const VectorBatchRow& other) const {
+        static_assert(!std::is_const_v<T>, "row of a const batch is read-only");
+        assign(other);
+        return *this;
+    }
+
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    const VectorBatchRow& operator=(const E& e) const {
+        static_assert(!std::is_const_v<T>, "row of a const batch is read-only");
+        assign(e);
+        return *this;
+    }
+
+    T& operator[](int index) const { return batch_->column(detail::access_index(index, N))[row_]; }
+    T& at(int index) const { return batch_->column(detail::normalize_index(index, N))[row_]; }
+    T& at_unchecked(std::size_t index) const noexcept { return batch_->column(index)[row_]; }
+    value_type eval(std::size_t index) const noexcept { return batch_->column(index)[row_]; }
+
+    constexpr std::size_t size() const noexcept { return N; }
+    std::size_t row() const noexcept { return row_; }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const VectorBatchRow& r) {
+        detail::print_expression(os, r);
+        return os;
+    }
+
+private:
+    batch_type* batch_;
+    std::size_t row_;
+
+    template<typename E>
+    void assign(const E& e) const {
+        // Спершу обчислюємо весь рядок: праворуч може бути цей самий рядок
+        Vector<value_type, N> tmp(e);
+        for (std::size_t i = 0; i < N; ++i)
+            batch_->column(i)[row_] = tmp.at_unchecked(i);
+    }
+};
+
+template<typename T, std::size_t N>
+struct is_vector_expression<VectorBatchRow<T, N>> : std::true_type {};
+
+namespace detail {
+
+template<typename R, typename A, typename B, typename Op>
+void column_transform(const A* a, const B* b, R* out, std::size_t n, Op op) {
+    if constexpr (std::is_same_v<A, R> && std::is_same_v<B, R>) {
+        dispatch::transform(a, b, out, n, op);
+    } else {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = static_cast<R>(op(a[i], b[i]));
+    }
+}
+
+template<typename R, typename A, typename S, typename Op>
+void column_transform_scalar(const A* a, const S& scalar, R* out, std::size_t n, Op op) {
+    if constexpr (std::is_same_v<A, R> && std::is_same_v<S, R>) {
+        dispatch::transform_scalar(a, scalar, out, n, op);
+    } else {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = static_cast<R>(op(a[i], scalar));
+    }
+}
+
+[[noreturn]] VECTOR_COLD inline void fail_size_mismatch(const char* what, std::size_t a, std::size_t b) {
+    char message[96];
+    std::snprintf(message, sizeof message, "%s size mismatch: %zu vs %zu", what, a, b);
+    raise_error<std::invalid_argument>(message);
+}
+
+inline void check_batch_sizes(std::size_t a, std::size_t b) {
+    VECTOR_EXPECTS(a == b, fail_size_mismatch("VectorBatch", a, b));
+}
+
+} // namespace detail
+
+template<typename T, std::size_t N>
+class VectorBatch {
+public:
+    using value_type = T;
+    static constexpr std::size_t dimension = N;
+    static constexpr std::size_t column_alignment = 64;
+    using column_type = std::vector<T, AlignedAllocator<T, column_alignment>>;
+    using row_reference = VectorBatchRow<T, N>;
+    using const_row_reference = VectorBatchRow<const T, N>;
+
+    VectorBatch() = default;
+
+    explicit VectorBatch(std::size_t count, const T& value = T{}) {
+        for (auto& c : columns_)
+            c.assign(count, value);
+    }
+
+    VectorBatch(std::size_t count, const Vector<T, N>& value) {
+        for (std::size_t i = 0; i < N; ++i)
+            columns_[i].assign(count, value.at_unchecked(i));
+    }
+
+    template<typename It, typename = decltype(*std::declval<It&>()), typename = decltype(++std::declval<It&>())>
+    VectorBatch(It first, It last) {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    std::size_t size() const noexcept { return columns_[0].size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    void reserve(std::size_t count) {
+        for (auto& c : columns_)
+            c.reserve(count);
+    }
+
+    void resize(std::size_t count) {
+        for (auto& c : columns_)
+            c.resize(count);
+    }
+
+    void clear() noexcept {
+        for (auto& c : columns_)
+            c.clear();
+    }
+
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    void push_back(const E& v) {
+        const Vector<T, N> tmp(v);
+        for (std::size_t i = 0; i < N; ++i)
+            columns_[i].push_back(tmp.at_unchecked(i));
+    }
+
+    T* column(std::size_t c) noexcept { return columns_[c].data(); }
+    const T* column(std::size_t c) const noexcept { return columns_[c].data(); }
+
+    row_reference operator[](std::size_t row) noexcept { return row_reference(*this, row); }
+    const_row_reference operator[](std::size_t row) const noexcept { return const_row_reference(*this, row); }
+
+    Vector<T, N> row(std::size_t r) const { return Vector<T, N>((*this)[r]); }
+
+    template<typename U>
+    auto operator+(const VectorBatch<U, N>& other) const { return apply_batch(other, std::plus<>{}); }
+    template<typename U>
+    auto operator-(const VectorBatch<U, N>& other) const { return apply_batch(other, std::minus<>{}); }
+    template<typename U>
+    auto operator*(const VectorBatch<U, N>& other) const { return apply_batch(other, std::multiplies<>{}); }
+    template<typename U>
+    auto operator/(const VectorBatch<U, N>& other) const { return apply_batch(other, std::divides<>{}); }
+
+    template<typename U>
+    auto operator+(const U& scalar) const { return apply_scalar(scalar, std::plus<>{}); }
+    template<typename U>
+    auto operator-(const U& scalar) const { return apply_scalar(scalar, std::minus<>{}); }
+    template<typename U>
+    auto operator*(const U& scalar) const { return apply_scalar(scalar, std::multiplies<>{}); }
+    template<typename U>
+    auto operator/(const U& scalar) const { return apply_scalar(scalar, std::divides<>{}); }
+
+    template<typename U>
+    VectorBatch& operator+=(const U& rhs) { return apply_in_place(rhs, std::plus<>{}); }
+    template<typename U>
+    VectorBatch& operator-=(const U& rhs) { return apply_in_place(rhs, std::minus<>{}); }
+    template<typename U>
+    VectorBatch& operator*=(const U& rhs) { return apply_in_place(rhs, std::multiplies<>{}); }
+    template<typename U>
+    VectorBatch& operator/=(const U& rhs) { return apply_in_place(rhs, std::divides<>{}); }
+
+    // Стовпці перетворюються ядрами simd::convert: float <-> double <-> float16/bfloat16,
+    // розширення цілих; дійсне -> ціле відкидає дробову частину з насиченням
+    template<typename U>
+    auto convert() const {
+        VECTOR_COUNT_CALL(instrumentation::Op::convert, N * size());
+        VectorBatch<U, N> result(size());
+        for (std::size_t c = 0; c < N; ++c) {
+            const T* in = column(c);
+            U* out = result.column(c);
+            if constexpr (simd::has_conversion_v<T, U>) {
+                dispatch::convert(in, out, size());
+            } else {
+                for (std::size_t i = 0, n = size(); i < n; ++i)
+                    out[i] = static_cast<U>(in[i]);
+            }
+        }
+        return result;
+    }
+
+    // Квантизація: ціле U з округленням mode і насиченням до меж U
+    template<typename U>
+    VectorBatch<U, N> saturate_convert(Rounding mode = Rounding::nearest) const {
+        VECTOR_COUNT_CALL(instrumentation::Op::convert, N * size());
+        VectorBatch<U, N> result(size());
+        for (std::size_t c = 0; c < N; ++c)
+            simd::saturate_convert(column(c), result.column(c), size(), mode);
+        return result;
+    }
+
+private:
+    std::array<column_type, N> columns_;
+
+    template<typename U, typename Op>
+    auto apply_scalar(const U& scalar, Op op) const {
+        using R = Promote<T, U>;
+        using S = detail::scalar_storage_t<T, U>;
+        VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), N * size());
+        VectorBatch<R, N> result(size());
+        for (std::size_t c = 0; c < N; ++c)
+            detail::column_transform_scalar(column(c), static_cast<S>(scalar), result.column(c), size(), op);
+        return result;
+    }
+
+    template<typename U, typename Op>
+    auto apply_batch(const VectorBatch<U, N>& other, Op op) const {
+        using R = Promote<T, U>;
+        detail::check_batch_sizes(size(), other.size());
+        VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), N * size());
+        VectorBatch<R, N> result(size());
+        for (std::size_t c = 0; c < N; ++c)
+            detail::column_transform(column(c), other.column(c), result.column(c), size(), op);
+        return result;
+    }
+
+    template<typename U, typename Op>
+    VectorBatch& apply_in_place(const U& rhs, Op op) {
+        VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), N * size());
+        if constexpr (is_vector_batch_v<U>) {
+            static_assert(std::decay_t<U>::dimension == N, "vector dimensions must match");
+            detail::check_batch_sizes(size(), rhs.size());
+            for (std::size_t c = 0; c < N; ++c)
+                detail::column_transform(column(c), rhs.column(c), column(c), size(), op);
+        } else {
+            using S = detail::scalar_storage_t<T, U>;
+            for (std::size_t c = 0; c < N; ++c)
+                detail::column_transform_scalar(column(c), static_cast<S>(rhs), column(c), size(), op);
+        }
+        return *this;
+    }
+};
+
+template<typename T, std::size_t N, typename U, typename T2>
+VectorBatch<T, N>& axpy(VectorBatch<T, N>& acc, const U& alpha, const VectorBatch<T2, N>& x) {
+    detail::check_batch_sizes(acc.size(), x.size());
+    const std::size_t n = acc.size();
+    VECTOR_COUNT_CALL(instrumentation::Op::axpy, N * n);
+    for (std::size_t c = 0; c < N; ++c) {
+        T* y = acc.column(c);
+        const T2* xc = x.column(c);
+        if constexpr (std::is_same_v<T, T2> && std::is_arithmetic_v<T> && std::is_arithmetic_v<U> &&
+                      std::is_same_v<Promote<T, U>, T>) {
+            dispatch::axpy(static_cast<T>(alpha), xc, y, n);
+        } else {
+            for (std::size_t i = 0; i < n; ++i)
+                y[i] = static_cast<T>(y[i] + alpha * xc[i]);
+        }
+    }
+    return acc;
+}
+
+template<typename T1, std::size_t N, typename U1, typename T2, typename U2>
+auto weighted_sum(const VectorBatch<T1, N>& b1,
+                  const U1& alpha,
+                  const VectorBatch<T2, N>& b2,
+                  const U2& beta) {
+    using R1 = std::common_type_t<T1, U1>;
+    using R2 = std::common_type_t<T2, U2>;
+    using R  = typename PromoteMultiple<R1, R2>::type;
+    detail::check_batch_sizes(b1.size(), b2.size());
+    const std::size_t n = b1.size();
+    VECTOR_COUNT_CALL(instrumentation::Op::weighted_sum, N * n);
+    VectorBatch<R, N> result(n);
+    for (std::size_t c = 0; c < N; ++c) {
+        const T1* x = b1.column(c);
+        const T2* y = b2.column(c);
+        R* out = result.column(c);
+        if constexpr (std::is_same_v<T1, R> && std::is_same_v<T2, R> &&
+                      std::is_arithmetic_v<U1> && std::is_arithmetic_v<U2>) {
+            dispatch::axpby(static_cast<R>(alpha), x, static_cast<R>(beta), y, out, n);
+        } else {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = alpha * x[i] + beta * y[i];
+        }
+    }
+    return result;
+}
+
+namespace detail {
+
+template<typename Tuple, std::size_t... I>
+auto batch_linear_combination_impl(const Tuple& args, std::index_sequence<I...>) {
+    using Types = std::decay_t<Tuple>;
+    constexpr std::size_t K = sizeof...(I);
+    constexpr std::size_t N = std::decay_t<std::tuple_element_t<0, Types>>::dimension;
+    static_assert(((std::decay_t<std::tuple_element_t<2 * I, Types>>::dimension == N) && ...),
+                  "vector dimensions must match");
+    using R = typename PromoteMultiple<typename std::decay_t<std::tuple_element_t<2 * I, Types>>::value_type...,
+                                       std::decay_t<std::tuple_element_t<2 * I + 1, Types>>...>::type;
+    const std::size_t n = std::get<0>(args).size();
+    (check_batch_sizes(n, std::get<2 * I>(args).size()), ...);
+    VECTOR_COUNT_CALL(instrumentation::Op::weighted_sum, N * K * n);
+    VectorBatch<R, N> result(n);
+    for (std::size_t c = 0; c < N; ++c) {
+        R* out = result.column(c);
+        if constexpr (((std::is_same_v<typename std::decay_t<std::tuple_element_t<2 * I, Types>>::value_type, R> &&
+                        std::is_arithmetic_v<std::decay_t<std::tuple_element_t<2 * I + 1, Types>>>) && ...)) {
+            simd::linear_combination<R, K>({std::get<2 * I>(args).column(c)...},
+                                           {static_cast<R>(std::get<2 * I + 1>(args))...}, out, n);
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                R acc{};
+                ((acc = (I == 0)
+                      ? static_cast<R>(static_cast<R>(std::get<1>(args)) * static_cast<R>(std::get<0>(args).column(c)[i]))
+                      : simd::mul_add(static_cast<R>(std::get<2 * I + 1>(args)),
+                                      static_cast<R>(std::get<2 * I>(args).column(c)[i]), acc)), ...);
+                out[i] = acc;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+// Те саме, що linear_combination для Vector, але по стовпцях пакетів однакового розміру
+template<typename B, typename... Args, std::enable_if_t<is_vector_batch_v<B>, int> = 0>
+auto linear_combination(const B& first, const Args&... rest) {
+    static_assert(sizeof...(Args) % 2 == 1, "linear_combination expects (batch, coefficient) pairs");
+    return detail::batch_linear_combination_impl(std::forward_as_tuple(first, rest...),
+                                                 std::make_index_sequence<(sizeof...(Args) + 1) / 2>{});
+}
+
+#if VECTOR_EXTERN_TEMPLATES
+#  define VECTOR_EXTERN_BATCH(T, N) extern template class VectorBatch<T, N>;
+VECTOR_FOR_EACH_INSTANCE(VECTOR_EXTERN_BATCH)
+#  undef VECTOR_EXTERN_BATCH
+#endif
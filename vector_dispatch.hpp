@@ -0,0 +1,533 @@
+// Диспетчеризація під час виконання: один бінарник, пакетні ядра під кожен набір інструкцій
+#pragma once
+
+#include "vector.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+// ---- Вибір ядер за можливостями процесора ----
+// Ядра над масивами float/double (поелементні операції, axpy/axpby, згортки, float <-> double)
+// зібрано окремо для кожного набору інструкцій; при першому зверненні бібліотека один раз
+// визначає можливості процесора і прив'язує покажчики на ядра найкращого набору.
+// З -DVECTOR_RUNTIME_DISPATCH=1 через ці ядра йдуть стовпцеві операції VectorBatch і DynVector,
+// тож збірка під базовий x86-64 використовує AVX2/AVX-512 там, де вони є. Без нього пакетні
+// операції лишаються на наборі, вибраному під час компіляції, а таблиці доступні явно.
+// Малі Vector<T, N> завжди використовують simd::Packet: непрямий виклик коштує більше за операцію.
+
+#ifndef VECTOR_RUNTIME_DISPATCH
+#  define VECTOR_RUNTIME_DISPATCH 0
+#endif
+
+// На x86 GCC і Clang вміють компілювати окремі функції під ширший набір (__attribute__((target))),
+// деінде в бінарнику є лише скалярні ядра і набір, під який зібрано
+#if !defined(VECTOR_DISABLE_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#  define VECTOR_DISPATCH_X86 1
+#  include <immintrin.h>
+#  define VECTOR_TARGET_SSE2 __attribute__((target("sse2")))
+#  define VECTOR_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#  define VECTOR_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#elif defined(VECTOR_SIMD_AVX512) || defined(VECTOR_SIMD_AVX2) || defined(VECTOR_SIMD_SSE2) || \
+      defined(VECTOR_SIMD_NEON)
+#  define VECTOR_DISPATCH_NATIVE 1
+#endif
+
+namespace dispatch {
+
+enum class Isa { scalar, sse2, avx2, avx512, neon };
+
+// Від гіршого до кращого: найкращий підтримуваний - останній
+inline constexpr Isa all_isas[] = {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512, Isa::neon};
+
+#if defined(VECTOR_SIMD_AVX512)
+inline constexpr Isa compiled_isa = Isa::avx512;
+#elif defined(VECTOR_SIMD_AVX2)
+inline constexpr Isa compiled_isa = Isa::avx2;
+#elif defined(VECTOR_SIMD_SSE2)
+inline constexpr Isa compiled_isa = Isa::sse2;
+#elif defined(VECTOR_SIMD_NEON)
+inline constexpr Isa compiled_isa = Isa::neon;
+#else
+inline constexpr Isa compiled_isa = Isa::scalar;
+#endif
+
+constexpr const char* isa_name(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::scalar: return "scalar";
+    case Isa::sse2: return "sse2";
+    case Isa::avx2: return "avx2";
+    case Isa::avx512: return "avx512";
+    case Isa::neon: return "neon";
+    }
+    return "scalar";
+}
+
+inline bool parse_isa(std::string_view name, Isa& out) noexcept {
+    for (const Isa isa : all_isas) {
+        if (name == isa_name(isa)) {
+            out = isa;
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+inline constexpr bool dispatchable_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Таблиця ядер одного набору. min/max вимагають n > 0
+template<typename T>
+struct Kernels {
+    static_assert(dispatchable_v<T>, "dispatch kernels exist for float and double");
+    using convert_type = std::conditional_t<std::is_same_v<T, float>, double, float>;
+    using binary_fn = void (*)(const T*, const T*, T*, std::size_t);
+    using scalar_fn = void (*)(const T*, T, T*, std::size_t);
+
+    Isa isa;
+    binary_fn add, sub, mul, div;
+    scalar_fn add_scalar, sub_scalar, mul_scalar, div_scalar;
+    void (*axpby)(T alpha, const T* a, T beta, const T* b, T* out, std::size_t n);
+    void (*axpy)(T alpha, const T* x, T* y, std::size_t n);
+    T (*sum)(const T* p, std::size_t n);
+    T (*dot)(const T* a, const T* b, std::size_t n);
+    T (*min)(const T* p, std::size_t n);
+    T (*max)(const T* p, std::size_t n);
+    void (*convert)(const T* in, convert_type* out, std::size_t n);
+};
+
+} // namespace dispatch
+
+// ---- Пакети окремих наборів для ядер диспетчеризації ----
+// Той самий інтерфейс, що й simd::Packet, але кожна функція має власний атрибут target,
+// тому в одній збірці співіснують AVX-512 і SSE2. convert_packets(in, out, n) перетворює
+// float <-> double префікс, кратний ширині, і повертає його довжину.
+
+namespace simd::isa {
+
+// Ширина 1: ті самі ядра без інтринсиків (компілятор може векторизувати їх сам)
+template<typename T>
+struct Scalar {
+    using type = T;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 1;
+    static type load(const T* p) { return *p; }
+    static void store(T* p, type v) { *p = v; }
+    static type broadcast(T s) { return s; }
+    static type add(type a, type b) { return a + b; }
+    static type sub(type a, type b) { return a - b; }
+    static type min(type a, type b) { return b < a ? b : a; }
+    static type max(type a, type b) { return a < b ? b : a; }
+    static type mul(type a, type b) { return a * b; }
+    static type fma(type a, type b, type c) { return a * b + c; }
+    static type div(type a, type b) { return a / b; }
+    template<typename D>
+    static std::size_t convert_packets(const T*, D*, std::size_t) { return 0; }
+};
+
+#if defined(VECTOR_DISPATCH_X86)
+
+template<typename T>
+struct Sse2;
+
+template<>
+struct Sse2<float> {
+    using type = __m128;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 4;
+    VECTOR_TARGET_SSE2 static type load(const float* p) { return _mm_loadu_ps(p); }
+    VECTOR_TARGET_SSE2 static void store(float* p, type v) { _mm_storeu_ps(p, v); }
+    VECTOR_TARGET_SSE2 static type broadcast(float s) { return _mm_set1_ps(s); }
+    VECTOR_TARGET_SSE2 static type add(type a, type b) { return _mm_add_ps(a, b); }
+    VECTOR_TARGET_SSE2 static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+    VECTOR_TARGET_SSE2 static type min(type a, type b) { return _mm_min_ps(a, b); }
+    VECTOR_TARGET_SSE2 static type max(type a, type b) { return _mm_max_ps(a, b); }
+    VECTOR_TARGET_SSE2 static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+    VECTOR_TARGET_SSE2 static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+    VECTOR_TARGET_SSE2 static type div(type a, type b) { return _mm_div_ps(a, b); }
+    VECTOR_TARGET_SSE2 static std::size_t convert_packets(const float* in, double* out, std::size_t n) {
+        std::size_t i = 0;
+        for (const std::size_t full = n - n % 4; i < full; i += 4) {
+            const __m128 x = _mm_loadu_ps(in + i);
+            _mm_storeu_pd(out + i, _mm_cvtps_pd(x));
+            _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+        }
+        return i;
+    }
+};
+
+template<>
+struct Sse2<double> {
+    using type = __m128d;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 2;
+    VECTOR_TARGET_SSE2 static type load(const double* p) { return _mm_loadu_pd(p); }
+    VECTOR_TARGET_SSE2 static void store(double* p, type v) { _mm_storeu_pd(p, v); }
+    VECTOR_TARGET_SSE2 static type broadcast(double s) { return _mm_set1_pd(s); }
+    VECTOR_TARGET_SSE2 static type add(type a, type b) { return _mm_add_pd(a, b); }
+    VECTOR_TARGET_SSE2 static type sub(type a, type b) { return _mm_sub_pd(a, b); }
+    VECTOR_TARGET_SSE2 static type min(type a, type b) { return _mm_min_pd(a, b); }
+    VECTOR_TARGET_SSE2 static type max(type a, type b) { return _mm_max_pd(a, b); }
+    VECTOR_TARGET_SSE2 static type mul(type a, type b) { return _mm_mul_pd(a, b); }
+    VECTOR_TARGET_SSE2 static type fma(type a, type b, type c) { return add(mul(a, b), c); }
+    VECTOR_TARGET_SSE2 static type div(type a, type b) { return _mm_div_pd(a, b); }
+    VECTOR_TARGET_SSE2 static std::size_t convert_packets(const double* in, float* out, std::size_t n) {
+        std::size_t i = 0;
+        for (const std::size_t full = n - n % 4; i < full; i += 4)
+            _mm_storeu_ps(out + i, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(in + i)), _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2))));
+        return i;
+    }
+};
+
+template<typename T>
+struct Avx2;
+
+template<>
+struct Avx2<float> {
+    using type = __m256;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 8;
+    VECTOR_TARGET_AVX2 static type load(const float* p) { return _mm256_loadu_ps(p); }
+    VECTOR_TARGET_AVX2 static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+    VECTOR_TARGET_AVX2 static type broadcast(float s) { return _mm256_set1_ps(s); }
+    VECTOR_TARGET_AVX2 static type add(type a, type b) { return _mm256_add_ps(a, b); }
+    VECTOR_TARGET_AVX2 static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+    VECTOR_TARGET_AVX2 static type min(type a, type b) { return _mm256_min_ps(a, b); }
+    VECTOR_TARGET_AVX2 static type max(type a, type b) { return _mm256_max_ps(a, b); }
+    VECTOR_TARGET_AVX2 static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+    VECTOR_TARGET_AVX2 static type fma(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+    VECTOR_TARGET_AVX2 static type div(type a, type b) { return _mm256_div_ps(a, b); }
+    VECTOR_TARGET_AVX2 static std::size_t convert_packets(const float* in, double* out, std::size_t n) {
+        std::size_t i = 0;
+        for (const std::size_t full = n - n % 4; i < full; i += 4)
+            _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+        return i;
+    }
+};
+
+template<>
+struct Avx2<double> {
+    using type = __m256d;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 4;
+    VECTOR_TARGET_AVX2 static type load(const double* p) { return _mm256_loadu_pd(p); }
+    VECTOR_TARGET_AVX2 static void store(double* p, type v) { _mm256_storeu_pd(p, v); }
+    VECTOR_TARGET_AVX2 static type broadcast(double s) { return _mm256_set1_pd(s); }
+    VECTOR_TARGET_AVX2 static type add(type a, type b) { return _mm256_add_pd(a, b); }
+    VECTOR_TARGET_AVX2 static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+    VECTOR_TARGET_AVX2 static type min(type a, type b) { return _mm256_min_pd(a, b); }
+    VECTOR_TARGET_AVX2 static type max(type a, type b) { return _mm256_max_pd(a, b); }
+    VECTOR_TARGET_AVX2 static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+    VECTOR_TARGET_AVX2 static type fma(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+    VECTOR_TARGET_AVX2 static type div(type a, type b) { return _mm256_div_pd(a, b); }
+    VECTOR_TARGET_AVX2 static std::size_t convert_packets(const double* in, float* out, std::size_t n) {
+        std::size_t i = 0;
+        for (const std::size_t full = n - n % 4; i < full; i += 4)
+            _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+        return i;
+    }
+};
+
+// min/max і перетворення через maskz-варіанти з повною маскою: ті самі інструкції, але
+// без _mm512_undefined_*, на якому GCC 12 дає хибне -Wmaybe-uninitialized у кожній збірці
+template<typename T>
+struct Avx512;
+
+template<>
+struct Avx512<float> {
+    using type = __m512;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 16;
+    VECTOR_TARGET_AVX512 static type load(const float* p) { return _mm512_loadu_ps(p); }
+    VECTOR_TARGET_AVX512 static void store(float* p, type v) { _mm512_storeu_ps(p, v); }
+    VECTOR_TARGET_AVX512 static type broadcast(float s) { return _mm512_set1_ps(s); }
+    VECTOR_TARGET_AVX512 static type add(type a, type b) { return _mm512_add_ps(a, b); }
+    VECTOR_TARGET_AVX512 static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+    VECTOR_TARGET_AVX512 static type min(type a, type b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+    VECTOR_TARGET_AVX512 static type max(type a, type b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+    VECTOR_TARGET_AVX512 static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+    VECTOR_TARGET_AVX512 static type fma(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+    VECTOR_TARGET_AVX512 static type div(type a, type b) { return _mm512_div_ps(a, b); }
+    VECTOR_TARGET_AVX512 static std::size_t convert_packets(const float* in, double* out, std::size_t n) {
+        std::size_t i = 0;
+        for (const std::size_t full = n - n % 8; i < full; i += 8)
+            _mm512_storeu_pd(out + i, _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(in + i)));
+        return i;
+    }
+};
+
+template<>
+struct Avx512<double> {
+    using type = __m512d;
+    static constexpr bool enabled = true, has_mul = true, has_div = true;
+    static constexpr bool has_minmax = true;
+    static constexpr std::size_t width = 8;
+    VECTOR_TARGET_AVX512 static type load(const double* p) { return _mm512_loadu_pd(p); }
+    VECTOR_TARGET_AVX512 static void store(double* p, type v) { _mm512_storeu_pd(p, v); }
+    VECTOR_TARGET_AVX512 static type broadcast(double s) { return _mm512_set1_pd(s); }
+    VECTOR_TARGET_AVX512 static type add(type a, type b) { return _mm512_add_pd(a, b); }
+    VECTOR_TARGET_AVX512 static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+    VECTOR_TARGET_AVX512 static type min(type a, type b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+    VECTOR_TARGET_AVX512 static type max(type a, type b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+    VECTOR_TARGET_AVX512 static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+    VECTOR_TARGET_AVX512 static type fma(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+    VECTOR_TARGET_AVX512 static type div(type a, type b) { return _mm512_div_pd(a, b); }
+    VECTOR_TARGET_AVX512 static std::size_t convert_packets(const double* in, float* out, std::size_t n) {
+        std::size_t i = 0;
+        for (const std::size_t full = n - n % 8; i < full; i += 8)
+            _mm256_storeu_ps(out + i, _mm512_maskz_cvtpd_ps(0xFF, _mm512_loadu_pd(in + i)));
+        return i;
+    }
+};
+
+#elif defined(VECTOR_DISPATCH_NATIVE)
+
+// Набір, під який зібрано: звичайний simd::Packet
+template<typename T>
+struct Native : Packet<T> {
+    template<typename D>
+    static std::size_t convert_packets(const T* in, D* out, std::size_t n) { return simd::convert_packets(in, out, n); }
+};
+
+#endif
+
+} // namespace simd::isa
+
+#define VECTOR_KERNEL_NS scalar
+#define VECTOR_KERNEL_ISA scalar
+#define VECTOR_KERNEL_PACKET simd::isa::Scalar
+#define VECTOR_KERNEL_TARGET
+#include "vector_dispatch_kernels.hpp"
+
+#if defined(VECTOR_DISPATCH_X86)
+
+#define VECTOR_KERNEL_NS sse2
+#define VECTOR_KERNEL_ISA sse2
+#define VECTOR_KERNEL_PACKET simd::isa::Sse2
+#define VECTOR_KERNEL_TARGET VECTOR_TARGET_SSE2
+#include "vector_dispatch_kernels.hpp"
+
+#define VECTOR_KERNEL_NS avx2
+#define VECTOR_KERNEL_ISA avx2
+#define VECTOR_KERNEL_PACKET simd::isa::Avx2
+#define VECTOR_KERNEL_TARGET VECTOR_TARGET_AVX2
+#include "vector_dispatch_kernels.hpp"
+
+#define VECTOR_KERNEL_NS avx512
+#define VECTOR_KERNEL_ISA avx512
+#define VECTOR_KERNEL_PACKET simd::isa::Avx512
+#define VECTOR_KERNEL_TARGET VECTOR_TARGET_AVX512
+#include "vector_dispatch_kernels.hpp"
+
+#elif defined(VECTOR_DISPATCH_NATIVE)
+
+#define VECTOR_KERNEL_NS native
+#if defined(VECTOR_SIMD_AVX512)
+#  define VECTOR_KERNEL_ISA avx512
+#elif defined(VECTOR_SIMD_AVX2)
+#  define VECTOR_KERNEL_ISA avx2
+#elif defined(VECTOR_SIMD_SSE2)
+#  define VECTOR_KERNEL_ISA sse2
+#else
+#  define VECTOR_KERNEL_ISA neon
+#endif
+#define VECTOR_KERNEL_PACKET simd::isa::Native
+#define VECTOR_KERNEL_TARGET
+#include "vector_dispatch_kernels.hpp"
+
+#endif
+
+namespace dispatch {
+
+// Таблиця набору isa або nullptr, якщо його ядер немає в бінарнику
+template<typename T>
+const Kernels<T>* kernels_for(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::scalar: return &detail::scalar::table<T>;
+#if defined(VECTOR_DISPATCH_X86)
+    case Isa::sse2: return &detail::sse2::table<T>;
+    case Isa::avx2: return &detail::avx2::table<T>;
+    case Isa::avx512: return &detail::avx512::table<T>;
+#elif defined(VECTOR_DISPATCH_NATIVE)
+    case compiled_isa: return &detail::native::table<T>;
+#endif
+    default: return nullptr;
+    }
+}
+
+// Чи виконує процесор інструкції набору (разом із підтримкою регістрів ОС для AVX)
+inline bool cpu_supports(Isa isa) noexcept {
+#if defined(VECTOR_DISPATCH_X86)
+    __builtin_cpu_init();
+    switch (isa) {
+    case Isa::scalar: return true;
+    case Isa::sse2: return __builtin_cpu_supports("sse2");
+    case Isa::avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::avx512: return __builtin_cpu_supports("avx512f");
+    case Isa::neon: return false;
+    }
+    return false;
+#else
+    // Без перевірки під час виконання: бінарник під compiled_isa і так вимагає його від процесора
+    return isa == Isa::scalar || isa == compiled_isa;
+#endif
+}
+
+// Набір можна вибрати: ядра є в бінарнику і процесор їх виконує
+inline bool supported(Isa isa) noexcept {
+    return kernels_for<float>(isa) != nullptr && cpu_supports(isa);
+}
+
+inline std::vector<Isa> supported_isas() {
+    std::vector<Isa> result;
+    for (const Isa isa : all_isas)
+        if (supported(isa))
+            result.push_back(isa);
+    return result;
+}
+
+namespace detail {
+
+// Найкращий підтримуваний набір; змінна середовища VECTOR_ISA (scalar, sse2, ...) обмежує
+// вибір без перезбирання, непідтримуване або невідоме значення ігнорується
+inline Isa detect_isa() {
+    Isa best = Isa::scalar;
+    for (const Isa isa : all_isas)
+        if (supported(isa))
+            best = isa;
+    Isa forced;
+    if (const char* env = std::getenv("VECTOR_ISA"); env && parse_isa(env, forced) && supported(forced))
+        return forced;
+    return best;
+}
+
+struct Binding {
+    std::atomic<Isa> isa;
+    std::atomic<const Kernels<float>*> f32;
+    std::atomic<const Kernels<double>*> f64;
+
+    explicit Binding(Isa selected) noexcept { bind(selected); }
+
+    void bind(Isa selected) noexcept {
+        f32.store(kernels_for<float>(selected), std::memory_order_release);
+        f64.store(kernels_for<double>(selected), std::memory_order_release);
+        isa.store(selected, std::memory_order_release);
+    }
+};
+
+} // namespace detail
+
+// Набір, визначений при першому зверненні (з урахуванням VECTOR_ISA)
+inline Isa detected_isa() {
+    static const Isa isa = detail::detect_isa();
+    return isa;
+}
+
+namespace detail {
+
+inline Binding& binding() {
+    static Binding b(detected_isa());
+    return b;
+}
+
+} // namespace detail
+
+inline Isa active_isa() noexcept { return detail::binding().isa.load(std::memory_order_acquire); }
+
+// Перемикає всі таблиці на isa; false, якщо набір не підтримується, і тоді вибір не змінюється.
+// Безпечно з будь-якого потоку, але операція, що вже виконується, доробляє старими ядрами
+inline bool set_isa(Isa isa) noexcept {
+    if (!supported(isa))
+        return false;
+    detail::binding().bind(isa);
+    return true;
+}
+
+inline void reset_isa() noexcept { detail::binding().bind(detected_isa()); }
+
+// Прив'язані зараз ядра
+template<typename T>
+const Kernels<T>& kernels() noexcept {
+    if constexpr (std::is_same_v<T, float>)
+        return *detail::binding().f32.load(std::memory_order_acquire);
+    else
+        return *detail::binding().f64.load(std::memory_order_acquire);
+}
+
+// ---- Точки входу пакетних операцій ----
+// З VECTOR_RUNTIME_DISPATCH=1 float/double ідуть через kernels<T>(), решта - через simd::
+
+namespace detail {
+
+template<typename T, typename Op>
+inline constexpr bool kernel_op_v =
+    VECTOR_RUNTIME_DISPATCH && dispatchable_v<T> &&
+    (std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::minus<>> ||
+     std::is_same_v<Op, std::multiplies<>> || std::is_same_v<Op, std::divides<>>);
+
+template<typename Op, typename T>
+typename Kernels<T>::binary_fn binary_kernel(const Kernels<T>& k) noexcept {
+    if constexpr (std::is_same_v<Op, std::plus<>>) return k.add;
+    else if constexpr (std::is_same_v<Op, std::minus<>>) return k.sub;
+    else if constexpr (std::is_same_v<Op, std::multiplies<>>) return k.mul;
+    else return k.div;
+}
+
+template<typename Op, typename T>
+typename Kernels<T>::scalar_fn scalar_kernel(const Kernels<T>& k) noexcept {
+    if constexpr (std::is_same_v<Op, std::plus<>>) return k.add_scalar;
+    else if constexpr (std::is_same_v<Op, std::minus<>>) return k.sub_scalar;
+    else if constexpr (std::is_same_v<Op, std::multiplies<>>) return k.mul_scalar;
+    else return k.div_scalar;
+}
+
+} // namespace detail
+
+template<typename T, typename Op>
+void transform(const T* a, const T* b, T* out, std::size_t n, Op op) {
+    if constexpr (detail::kernel_op_v<T, Op>)
+        detail::binary_kernel<Op>(kernels<T>())(a, b, out, n);
+    else
+        simd::transform(a, b, out, n, op);
+}
+
+template<typename T, typename Op>
+void transform_scalar(const T* a, T scalar, T* out, std::size_t n, Op op) {
+    if constexpr (detail::kernel_op_v<T, Op>)
+        detail::scalar_kernel<Op>(kernels<T>())(a, scalar, out, n);
+    else
+        simd::transform_scalar(a, scalar, out, n, op);
+}
+
+template<typename T>
+void axpby(T alpha, const T* a, T beta, const T* b, T* out, std::size_t n) {
+    if constexpr (VECTOR_RUNTIME_DISPATCH && dispatchable_v<T>)
+        kernels<T>().axpby(alpha, a, beta, b, out, n);
+    else
+        simd::axpby(alpha, a, beta, b, out, n);
+}
+
+template<typename T>
+void axpy(T alpha, const T* x, T* y, std::size_t n) {
+    if constexpr (VECTOR_RUNTIME_DISPATCH && dispatchable_v<T>)
+        kernels<T>().axpy(alpha, x, y, n);
+    else
+        simd::axpy(alpha, x, y, n);
+}
+
+template<typename S, typename D>
+void convert(const S* in, D* out, std::size_t n) {
+    if constexpr (VECTOR_RUNTIME_DISPATCH && dispatchable_v<S> && dispatchable_v<D> && !std::is_same_v<S, D>)
+        kernels<S>().convert(in, out, n);
+    else
+        simd::convert(in, out, n);
+}
+
+} // namespace dispatch
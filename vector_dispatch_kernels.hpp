@@ -0,0 +1,194 @@
+// Пакетні ядра одного набору інструкцій для таблиць dispatch::Kernels<T>.
+// Без #pragma once: vector_dispatch.hpp включає файл для кожного набору, щоразу визначивши
+//   VECTOR_KERNEL_NS     - простір імен ядер усередині dispatch::detail
+//   VECTOR_KERNEL_ISA    - елемент dispatch::Isa
+//   VECTOR_KERNEL_PACKET - шаблон пакета з simd::isa
+//   VECTOR_KERNEL_TARGET - атрибут target цього набору або порожньо
+// Атрибут стоїть на кожній функції: ядро без нього не може вбудувати інтринсики ширшого набору.
+
+namespace dispatch::detail::VECTOR_KERNEL_NS {
+
+template<typename T>
+using P = VECTOR_KERNEL_PACKET<T>;
+
+template<typename T, typename Op>
+inline constexpr bool vectorized_v =
+    P<T>::enabled && (!std::is_same_v<Op, std::multiplies<>> || P<T>::has_mul) &&
+    (!std::is_same_v<Op, std::divides<>> || P<T>::has_div);
+
+template<typename T, typename V>
+VECTOR_KERNEL_TARGET inline V run(std::plus<>, V a, V b) { return P<T>::add(a, b); }
+template<typename T, typename V>
+VECTOR_KERNEL_TARGET inline V run(std::minus<>, V a, V b) { return P<T>::sub(a, b); }
+template<typename T, typename V>
+VECTOR_KERNEL_TARGET inline V run(std::multiplies<>, V a, V b) { return P<T>::mul(a, b); }
+template<typename T, typename V>
+VECTOR_KERNEL_TARGET inline V run(std::divides<>, V a, V b) { return P<T>::div(a, b); }
+
+template<typename T, typename Op>
+VECTOR_KERNEL_TARGET void binary(const T* a, const T* b, T* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (vectorized_v<T, Op>) {
+        for (const std::size_t full = n - n % P<T>::width; i < full; i += P<T>::width)
+            P<T>::store(out + i, run<T>(Op{}, P<T>::load(a + i), P<T>::load(b + i)));
+    }
+    for (; i < n; ++i)
+        out[i] = Op{}(a[i], b[i]);
+}
+
+template<typename T, typename Op>
+VECTOR_KERNEL_TARGET void binary_scalar(const T* a, T scalar, T* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (vectorized_v<T, Op>) {
+        const auto s = P<T>::broadcast(scalar);
+        for (const std::size_t full = n - n % P<T>::width; i < full; i += P<T>::width)
+            P<T>::store(out + i, run<T>(Op{}, P<T>::load(a + i), s));
+    }
+    for (; i < n; ++i)
+        out[i] = Op{}(a[i], scalar);
+}
+
+// Ті самі формули, що й simd::axpby / simd::axpy. Поелементні операції побітово однакові
+// на всіх наборах, а тут компілятор може злити множення з додаванням у FMA (-ffp-contract=fast)
+// там, де набір її має, і результат різниться в останньому біті
+template<typename T>
+VECTOR_KERNEL_TARGET void axpby(T alpha, const T* a, T beta, const T* b, T* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (vectorized_v<T, std::multiplies<>>) {
+        const auto va = P<T>::broadcast(alpha);
+        const auto vb = P<T>::broadcast(beta);
+        for (const std::size_t full = n - n % P<T>::width; i < full; i += P<T>::width)
+            P<T>::store(out + i, P<T>::add(P<T>::mul(va, P<T>::load(a + i)), P<T>::mul(vb, P<T>::load(b + i))));
+    }
+    for (; i < n; ++i)
+        out[i] = alpha * a[i] + beta * b[i];
+}
+
+template<typename T>
+VECTOR_KERNEL_TARGET void axpy(T alpha, const T* x, T* y, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (vectorized_v<T, std::multiplies<>>) {
+        const auto va = P<T>::broadcast(alpha);
+        for (const std::size_t full = n - n % P<T>::width; i < full; i += P<T>::width)
+            P<T>::store(y + i, P<T>::add(P<T>::load(y + i), P<T>::mul(va, P<T>::load(x + i))));
+    }
+    for (; i < n; ++i)
+        y[i] = y[i] + alpha * x[i];
+}
+
+template<typename T, typename V, typename F>
+VECTOR_KERNEL_TARGET T horizontal(V v, F f) {
+    alignas(64) T lanes[P<T>::width];
+    P<T>::store(lanes, v);
+    T r = lanes[0];
+    for (std::size_t k = 1; k < P<T>::width; ++k)
+        r = f(r, lanes[k]);
+    return r;
+}
+
+// Згортки: чотири акумулятори, як у simd::sum / simd::dot; порядок додавання
+// залежить від ширини пакета, тож суми різних наборів можуть різнитися в останніх бітах
+template<typename T>
+VECTOR_KERNEL_TARGET T sum(const T* p, std::size_t n) {
+    std::size_t i = 0;
+    T total{};
+    if constexpr (P<T>::enabled) {
+        constexpr std::size_t W = P<T>::width;
+        auto a0 = P<T>::broadcast(T{}), a1 = a0, a2 = a0, a3 = a0;
+        for (const std::size_t full = n - n % (4 * W); i < full; i += 4 * W) {
+            a0 = P<T>::add(a0, P<T>::load(p + i));
+            a1 = P<T>::add(a1, P<T>::load(p + i + W));
+            a2 = P<T>::add(a2, P<T>::load(p + i + 2 * W));
+            a3 = P<T>::add(a3, P<T>::load(p + i + 3 * W));
+        }
+        for (const std::size_t full = n - n % W; i < full; i += W)
+            a0 = P<T>::add(a0, P<T>::load(p + i));
+        total = horizontal<T>(P<T>::add(P<T>::add(a0, a1), P<T>::add(a2, a3)), std::plus<>{});
+    }
+    for (; i < n; ++i)
+        total += p[i];
+    return total;
+}
+
+template<typename T>
+VECTOR_KERNEL_TARGET T dot(const T* a, const T* b, std::size_t n) {
+    std::size_t i = 0;
+    T total{};
+    if constexpr (vectorized_v<T, std::multiplies<>>) {
+        constexpr std::size_t W = P<T>::width;
+        auto a0 = P<T>::broadcast(T{}), a1 = a0, a2 = a0, a3 = a0;
+        for (const std::size_t full = n - n % (4 * W); i < full; i += 4 * W) {
+            a0 = P<T>::add(a0, P<T>::mul(P<T>::load(a + i), P<T>::load(b + i)));
+            a1 = P<T>::add(a1, P<T>::mul(P<T>::load(a + i + W), P<T>::load(b + i + W)));
+            a2 = P<T>::add(a2, P<T>::mul(P<T>::load(a + i + 2 * W), P<T>::load(b + i + 2 * W)));
+            a3 = P<T>::add(a3, P<T>::mul(P<T>::load(a + i + 3 * W), P<T>::load(b + i + 3 * W)));
+        }
+        for (const std::size_t full = n - n % W; i < full; i += W)
+            a0 = P<T>::add(a0, P<T>::mul(P<T>::load(a + i), P<T>::load(b + i)));
+        total = horizontal<T>(P<T>::add(P<T>::add(a0, a1), P<T>::add(a2, a3)), std::plus<>{});
+    }
+    for (; i < n; ++i)
+        total += a[i] * b[i];
+    return total;
+}
+
+// n > 0; порядок обробки NaN не визначений
+template<typename T>
+VECTOR_KERNEL_TARGET T min(const T* p, std::size_t n) {
+    std::size_t i = 1;
+    T r = p[0];
+    if constexpr (P<T>::enabled && P<T>::has_minmax) {
+        if (n >= P<T>::width) {
+            auto acc = P<T>::load(p);
+            i = P<T>::width;
+            for (const std::size_t full = n - n % P<T>::width; i < full; i += P<T>::width)
+                acc = P<T>::min(acc, P<T>::load(p + i));
+            r = horizontal<T>(acc, [](T x, T y) { return y < x ? y : x; });
+        }
+    }
+    for (; i < n; ++i)
+        r = p[i] < r ? p[i] : r;
+    return r;
+}
+
+template<typename T>
+VECTOR_KERNEL_TARGET T max(const T* p, std::size_t n) {
+    std::size_t i = 1;
+    T r = p[0];
+    if constexpr (P<T>::enabled && P<T>::has_minmax) {
+        if (n >= P<T>::width) {
+            auto acc = P<T>::load(p);
+            i = P<T>::width;
+            for (const std::size_t full = n - n % P<T>::width; i < full; i += P<T>::width)
+                acc = P<T>::max(acc, P<T>::load(p + i));
+            r = horizontal<T>(acc, [](T x, T y) { return x < y ? y : x; });
+        }
+    }
+    for (; i < n; ++i)
+        r = r < p[i] ? p[i] : r;
+    return r;
+}
+
+// float <-> double: векторний префікс від пакета, хвіст - скалярно
+template<typename T>
+VECTOR_KERNEL_TARGET void convert(const T* in, typename Kernels<T>::convert_type* out, std::size_t n) {
+    std::size_t i = P<T>::convert_packets(in, out, n);
+    for (; i < n; ++i)
+        out[i] = static_cast<typename Kernels<T>::convert_type>(in[i]);
+}
+
+template<typename T>
+inline constexpr Kernels<T> table = {
+    Isa::VECTOR_KERNEL_ISA,
+    &binary<T, std::plus<>>, &binary<T, std::minus<>>, &binary<T, std::multiplies<>>, &binary<T, std::divides<>>,
+    &binary_scalar<T, std::plus<>>, &binary_scalar<T, std::minus<>>,
+    &binary_scalar<T, std::multiplies<>>, &binary_scalar<T, std::divides<>>,
+    &axpby<T>, &axpy<T>, &sum<T>, &dot<T>, &min<T>, &max<T>, &convert<T>,
+};
+
+} // namespace dispatch::detail::VECTOR_KERNEL_NS
+
+#undef VECTOR_KERNEL_NS
+#undef VECTOR_KERNEL_ISA
+#undef VECTOR_KERNEL_PACKET
+#undef VECTOR_KERNEL_TARGET
@@ -0,0 +1,334 @@
+// DynVector: розмір під час виконання з малою вбудованою пам'яттю
+#pragma once
+
+#include "vector_batch.hpp"
+#include <memory>
+#include <memory_resource>
+
+// ---- DynVector: розмір під час виконання, мала вбудована пам'ять і будь-який алокатор ----
+
+namespace detail {
+
+inline void check_dyn_sizes(std::size_t a, std::size_t b) {
+    VECTOR_EXPECTS(a == b, fail_size_mismatch("DynVector", a, b));
+}
+
+} // namespace detail
+
+// До inline_capacity елементів зберігаються всередині об'єкта, більші розміри -
+// через Alloc. Для тимчасової пам'яті на запит підходить
+// std::pmr::polymorphic_allocator з monotonic_buffer_resource (див. PmrDynVector).
+template<typename T, typename Alloc = std::allocator<T>>
+class DynVector {
+    using traits = std::allocator_traits<Alloc>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    static constexpr std::size_t inline_capacity = (sizeof(T) >= 64 ? 1 : 64 / sizeof(T));
+
+    DynVector() noexcept(noexcept(Alloc())) : DynVector(Alloc()) {}
+    explicit DynVector(const Alloc& alloc) noexcept : alloc_(alloc), data_(inline_data()) {}
+
+    explicit DynVector(std::size_t n, const Alloc& alloc = Alloc()) : DynVector(alloc) { resize(n); }
+
+    DynVector(std::size_t n, const T& value, const Alloc& alloc = Alloc()) : DynVector(alloc) {
+        reserve(n);
+        for (; size_ < n; ++size_)
+            traits::construct(alloc_, data_ + size_, value);
+    }
+
+    DynVector(std::initializer_list<T> values, const Alloc& alloc = Alloc()) : DynVector(alloc) {
+        reserve(values.size());
+        for (const T& v : values)
+            traits::construct(alloc_, data_ + size_++, v);
+    }
+
+    // З Vector, представлення чи виразу фіксованого розміру
+    template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+    explicit DynVector(const E& v, const Alloc& alloc = Alloc()) : DynVector(alloc) {
+        constexpr std::size_t N = std::decay_t<E>::dimension;
+        reserve(N);
+        for (; size_ < N; ++size_)
+            traits::construct(alloc_, data_ + size_, static_cast<T>(detail::element(v, size_)));
+    }
+
+    template<std::size_t N, std::size_t A>
+    explicit DynVector(Vector<T, N, A>&& v, const Alloc& alloc = Alloc()) : DynVector(alloc) {
+        reserve(N);
+        for (; size_ < N; ++size_)
+            traits::construct(alloc_, data_ + size_, std::move(v.at_unchecked(size_)));
+    }
+
+    DynVector(const DynVector& other)
+        : DynVector(other, traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    DynVector(const DynVector& other, const Alloc& alloc) : DynVector(alloc) {
+        reserve(other.size_);
+        for (; size_ < other.size_; ++size_)
+            traits::construct(alloc_, data_ + size_, other.data_[size_]);
+    }
+
+    DynVector(DynVector&& other) noexcept : alloc_(std::move(other.alloc_)), data_(inline_data()) {
+        take(other);
+    }
+
+    DynVector& operator=(const DynVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (; size_ < other.size_; ++size_)
+                traits::construct(alloc_, data_ + size_, other.data_[size_]);
+        }
+        return *this;
+    }
+
+    DynVector& operator=(DynVector&& other) noexcept(traits::is_always_equal::value) {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~DynVector() { release(); }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    T* begin() noexcept { return data_; }
+    T* end() noexcept { return data_ + size_; }
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size_; }
+
+    T& operator[](int index) { return data_[detail::access_index(index, size_)]; }
+    const T& operator[](int index) const { return data_[detail::access_index(index, size_)]; }
+    T& at(int index) { return data_[detail::normalize_index(index, size_)]; }
+    const T& at(int index) const { return data_[detail::normalize_index(index, size_)]; }
+    Expected<T> try_at(int index) const { return detail::checked_element(data_, index, size_); }
+    T& at_unchecked(std::size_t index) noexcept { return data_[index]; }
+    const T& at_unchecked(std::size_t index) const noexcept { return data_[index]; }
+
+    void reserve(std::size_t n) {
+        if (n <= capacity_)
+            return;
+        T* fresh = traits::allocate(alloc_, n);
+        for (std::size_t i = 0; i < size_; ++i) {
+            traits::construct(alloc_, fresh + i, std::move_if_noexcept(data_[i]));
+            traits::destroy(alloc_, data_ + i);
+        }
+        if (!is_inline())
+            traits::deallocate(alloc_, data_, capacity_);
+        data_ = fresh;
+        capacity_ = n;
+    }
+
+    void resize(std::size_t n) {
+        reserve(n);
+        for (; size_ < n; ++size_)
+            traits::construct(alloc_, data_ + size_);
+        while (size_ > n)
+            traits::destroy(alloc_, data_ + --size_);
+    }
+
+    // value може бути елементом цього ж вектора: перед зростанням береться копія,
+    // бо reserve() переміщує і знищує старі елементи
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            T copy(value);
+            reserve(capacity_ * 2);
+            traits::construct(alloc_, data_ + size_, std::move(copy));
+        } else {
+            traits::construct(alloc_, data_ + size_, value);
+        }
+        ++size_;
+    }
+
+    void clear() noexcept {
+        while (size_ > 0)
+            traits::destroy(alloc_, data_ + --size_);
+    }
+
+    // Без копіювання: представлення фіксованого розміру над цією пам'яттю
+    template<std::size_t N>
+    VectorView<T, N> view() {
+        detail::check_dyn_sizes(size_, N);
+        return VectorView<T, N>(data_);
+    }
+    template<std::size_t N>
+    VectorView<const T, N> view() const {
+        detail::check_dyn_sizes(size_, N);
+        return VectorView<const T, N>(data_);
+    }
+
+    template<std::size_t N>
+    Vector<T, N> to_vector() const { return Vector<T, N>(view<N>()); }
+
+    template<typename U>
+    auto operator+(const DynVector<U, typename traits::template rebind_alloc<U>>& other) const { return apply_vector(other, std::plus<>{}); }
+    template<typename U>
+    auto operator-(const DynVector<U, typename traits::template rebind_alloc<U>>& other) const { return apply_vector(other, std::minus<>{}); }
+    template<typename U>
+    auto operator*(const DynVector<U, typename traits::template rebind_alloc<U>>& other) const { return apply_vector(other, std::multiplies<>{}); }
+    template<typename U>
+    auto operator/(const DynVector<U, typename traits::template rebind_alloc<U>>& other) const { return apply_vector(other, std::divides<>{}); }
+
+    template<typename U>
+    auto operator+(const U& scalar) const { return apply_scalar(scalar, std::plus<>{}); }
+    template<typename U>
+    auto operator-(const U& scalar) const { return apply_scalar(scalar, std::minus<>{}); }
+    template<typename U>
+    auto operator*(const U& scalar) const { return apply_scalar(scalar, std::multiplies<>{}); }
+    template<typename U>
+    auto operator/(const U& scalar) const { return apply_scalar(scalar, std::divides<>{}); }
+
+    template<typename U>
+    DynVector& operator+=(const U& rhs) { return apply_in_place(rhs, std::plus<>{}); }
+    template<typename U>
+    DynVector& operator-=(const U& rhs) { return apply_in_place(rhs, std::minus<>{}); }
+    template<typename U>
+    DynVector& operator*=(const U& rhs) { return apply_in_place(rhs, std::multiplies<>{}); }
+    template<typename U>
+    DynVector& operator/=(const U& rhs) { return apply_in_place(rhs, std::divides<>{}); }
+
+    template<typename U>
+    auto convert() const {
+        DynVector<U, typename traits::template rebind_alloc<U>> result(size_, rebind<U>());
+        if constexpr (simd::has_conversion_v<T, U>) {
+            dispatch::convert(data_, result.data(), size_);
+        } else {
+            for (std::size_t i = 0; i < size_; ++i)
+                result.at_unchecked(i) = static_cast<U>(data_[i]);
+        }
+        return result;
+    }
+
+    template<typename U>
+    auto saturate_convert(Rounding mode = Rounding::nearest) const {
+        DynVector<U, typename traits::template rebind_alloc<U>> result(size_, rebind<U>());
+        simd::saturate_convert(data_, result.data(), size_, mode);
+        return result;
+    }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const DynVector& v) {
+        os << "[";
+        for (std::size_t i = 0; i < v.size_; ++i) {
+            os << v.data_[i] << (i + 1 < v.size_ ? ", " : "");
+        }
+        os << "]";
+        return os;
+    }
+
+private:
+    Alloc alloc_;
+    T* data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = inline_capacity;
+    alignas(T) unsigned char inline_[inline_capacity * sizeof(T)];
+
+    T* inline_data() noexcept { return reinterpret_cast<T*>(inline_); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+    template<typename U>
+    typename traits::template rebind_alloc<U> rebind() const {
+        return typename traits::template rebind_alloc<U>(alloc_);
+    }
+
+    void release() noexcept {
+        clear();
+        if (!is_inline())
+            traits::deallocate(alloc_, data_, capacity_);
+        data_ = inline_data();
+        capacity_ = inline_capacity;
+    }
+
+    // Забирає купу в other, якщо можна, інакше переміщує елементи поштучно
+    void take(DynVector& other) {
+        if (!other.is_inline() && alloc_ == other.alloc_) {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = inline_capacity;
+            return;
+        }
+        reserve(other.size_);
+        for (; size_ < other.size_; ++size_)
+            traits::construct(alloc_, data_ + size_, std::move(other.data_[size_]));
+        other.release();
+    }
+
+    template<typename U, typename Op>
+    auto apply_scalar(const U& scalar, Op op) const {
+        using R = Promote<T, U>;
+        using S = detail::scalar_storage_t<T, U>;
+        DynVector<R, typename traits::template rebind_alloc<R>> result(size_, rebind<R>());
+        detail::column_transform_scalar(data_, static_cast<S>(scalar), result.data(), size_, op);
+        return result;
+    }
+
+    template<typename U, typename A2, typename Op>
+    auto apply_vector(const DynVector<U, A2>& other, Op op) const {
+        using R = Promote<T, U>;
+        detail::check_dyn_sizes(size_, other.size());
+        DynVector<R, typename traits::template rebind_alloc<R>> result(size_, rebind<R>());
+        detail::column_transform(data_, other.data(), result.data(), size_, op);
+        return result;
+    }
+
+    template<typename U, typename Op>
+    DynVector& apply_in_place(const U& rhs, Op op) {
+        if constexpr (is_dyn_vector<U>::value) {
+            detail::check_dyn_sizes(size_, rhs.size());
+            detail::column_transform(data_, rhs.data(), data_, size_, op);
+        } else {
+            using S = detail::scalar_storage_t<T, U>;
+            detail::column_transform_scalar(data_, static_cast<S>(rhs), data_, size_, op);
+        }
+        return *this;
+    }
+
+    template<typename V>
+    struct is_dyn_vector : std::false_type {};
+    template<typename U, typename A2>
+    struct is_dyn_vector<DynVector<U, A2>> : std::true_type {};
+};
+
+template<typename T>
+using PmrDynVector = DynVector<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T1, typename A1, typename U1, typename T2, typename A2, typename U2>
+auto weighted_sum(const DynVector<T1, A1>& v1,
+                  const U1& alpha,
+                  const DynVector<T2, A2>& v2,
+                  const U2& beta) {
+    using R1 = std::common_type_t<T1, U1>;
+    using R2 = std::common_type_t<T2, U2>;
+    using R  = typename PromoteMultiple<R1, R2>::type;
+    detail::check_dyn_sizes(v1.size(), v2.size());
+    const std::size_t n = v1.size();
+    VECTOR_COUNT_CALL(instrumentation::Op::weighted_sum, n);
+    DynVector<R, typename std::allocator_traits<A1>::template rebind_alloc<R>> result(
+        n, typename std::allocator_traits<A1>::template rebind_alloc<R>(v1.get_allocator()));
+    if constexpr (std::is_same_v<T1, R> && std::is_same_v<T2, R> &&
+                  std::is_arithmetic_v<U1> && std::is_arithmetic_v<U2>) {
+        dispatch::axpby(static_cast<R>(alpha), v1.data(), static_cast<R>(beta), v2.data(), result.data(), n);
+    } else {
+        for (std::size_t i = 0; i < n; ++i)
+            result.at_unchecked(i) = alpha * v1.at_unchecked(i) + beta * v2.at_unchecked(i);
+    }
+    return result;
+}
+
+#if VECTOR_EXTERN_TEMPLATES
+#  define VECTOR_EXTERN_DYN(T) extern template class DynVector<T>;
+VECTOR_FOR_EACH_INSTANCE_TYPE(VECTOR_EXTERN_DYN)
+#  undef VECTOR_EXTERN_DYN
+#endif
@@ -0,0 +1,402 @@
+// Перенесення великих пакетних операцій VectorBatch на прискорювач через SYCL 2020.
+// Увімкнення: -DVECTOR_ENABLE_SYCL=1 і компілятор SYCL (icpx -fsycl, AdaptiveCpp acpp);
+// обидва вміють цілити і в GPU NVIDIA через CUDA. Без SYCL лишається gpu::Engine,
+// який рахує все на CPU тими самими batch_* з vector_parallel.hpp.
+// Експериментально: гілку VECTOR_HAS_SYCL ще не збирали справжнім компілятором SYCL.
+#pragma once
+
+#include "vector_parallel.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#ifndef VECTOR_ENABLE_SYCL
+#  define VECTOR_ENABLE_SYCL 0
+#endif
+
+#if VECTOR_ENABLE_SYCL && defined(__has_include)
+#  if __has_include(<sycl/sycl.hpp>)
+#    include <sycl/sycl.hpp>
+#    define VECTOR_HAS_SYCL 1
+#  endif
+#endif
+
+#if VECTOR_ENABLE_SYCL && !defined(VECTOR_HAS_SYCL)
+#  error "VECTOR_ENABLE_SYCL requires a SYCL 2020 compiler with <sycl/sycl.hpp>"
+#endif
+
+namespace gpu {
+
+// Пакети менші за min_size векторів рахує CPU з налаштуваннями cpu: поелементна операція
+// впирається в пропускну здатність пам'яті, і копіювання через шину коштує більше за неї саму
+struct OffloadConfig {
+    std::size_t min_size = std::size_t(1) << 22;
+    ExecutionConfig cpu{};
+};
+
+#if defined(VECTOR_HAS_SYCL)
+
+// ---- Device: черга команд одного пристрою ----
+
+// Черга in_order: кожна команда бачить результат попередньої без явних залежностей між подіями
+class Device {
+public:
+    Device() : queue_(sycl::default_selector_v, sycl::property::queue::in_order{}) {}
+    explicit Device(const sycl::device& device) : queue_(device, sycl::property::queue::in_order{}) {}
+
+    sycl::queue& queue() noexcept { return queue_; }
+    std::string name() const { return queue_.get_device().get_info<sycl::info::device::name>(); }
+    void wait() { queue_.wait_and_throw(); }
+
+private:
+    sycl::queue queue_;
+};
+
+// ---- DeviceBatch: стовпці пакета в пам'яті пристрою ----
+
+// Та сама структура масивів, що й у VectorBatch, одним блоком USM: стовпець c починається
+// з data() + c * size(). Буфер живе разом з об'єктом, тож проміжні результати ланцюжка
+// операцій не повертаються на хост. Операції лише ставляться в чергу; download() з подією,
+// wait() і деструктор чекають на неї.
+template<typename T, std::size_t N>
+class DeviceBatch {
+public:
+    using value_type = T;
+    static constexpr std::size_t dimension = N;
+
+    DeviceBatch(sycl::queue queue, std::size_t count) : queue_(std::move(queue)), size_(count) {
+        if (count == 0)
+            return;
+        data_ = sycl::malloc_device<T>(N * count, queue_);
+        if (!data_)
+            ::detail::raise_error<std::runtime_error>("DeviceBatch: device allocation failed");
+    }
+    DeviceBatch(Device& device, std::size_t count) : DeviceBatch(device.queue(), count) {}
+
+    DeviceBatch(DeviceBatch&& other) noexcept
+        : queue_(other.queue_), data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    DeviceBatch& operator=(DeviceBatch&& other) noexcept {
+        if (this != &other) {
+            release();
+            queue_ = other.queue_;
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+    DeviceBatch(const DeviceBatch&) = delete;
+    DeviceBatch& operator=(const DeviceBatch&) = delete;
+
+    ~DeviceBatch() { release(); }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    sycl::queue queue() const { return queue_; }
+
+    // Вказівники пристрою: розіменовувати лише в ядрах
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    T* column(std::size_t c) noexcept { return data_ + c * size_; }
+    const T* column(std::size_t c) const noexcept { return data_ + c * size_; }
+
+    // Асинхронне копіювання хост -> пристрій: host не можна змінювати чи знищувати до події
+    sycl::event upload(const VectorBatch<T, N>& host) {
+        ::detail::check_batch_sizes(size_, host.size());
+        sycl::event done;
+        if (size_ > 0)
+            for (std::size_t c = 0; c < N; ++c)
+                done = queue_.memcpy(column(c), host.column(c), size_ * sizeof(T));
+        return done;
+    }
+
+    // Асинхронне копіювання пристрій -> хост: host готовий після події
+    sycl::event download(VectorBatch<T, N>& host) const {
+        host.resize(size_);
+        sycl::queue queue = queue_;
+        sycl::event done;
+        if (size_ > 0)
+            for (std::size_t c = 0; c < N; ++c)
+                done = queue.memcpy(host.column(c), column(c), size_ * sizeof(T));
+        return done;
+    }
+
+    void wait() { queue_.wait_and_throw(); }
+
+    template<typename U>
+    auto operator+(const DeviceBatch<U, N>& other) const { return apply(*this, other, std::plus<>{}); }
+    template<typename U>
+    auto operator-(const DeviceBatch<U, N>& other) const { return apply(*this, other, std::minus<>{}); }
+    template<typename U>
+    auto operator*(const DeviceBatch<U, N>& other) const { return apply(*this, other, std::multiplies<>{}); }
+    template<typename U>
+    auto operator/(const DeviceBatch<U, N>& other) const { return apply(*this, other, std::divides<>{}); }
+
+    template<typename U>
+    auto operator+(const U& scalar) const { return apply_scalar(*this, scalar, std::plus<>{}); }
+    template<typename U>
+    auto operator-(const U& scalar) const { return apply_scalar(*this, scalar, std::minus<>{}); }
+    template<typename U>
+    auto operator*(const U& scalar) const { return apply_scalar(*this, scalar, std::multiplies<>{}); }
+    template<typename U>
+    auto operator/(const U& scalar) const { return apply_scalar(*this, scalar, std::divides<>{}); }
+
+    // Перетворення типу на пристрої з тим самим насиченням, що й VectorBatch::convert
+    template<typename U>
+    DeviceBatch<U, N> convert() const;
+
+private:
+    sycl::queue queue_;
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    void release() noexcept {
+        if (data_) {
+            queue_.wait();
+            sycl::free(data_, queue_);
+            data_ = nullptr;
+        }
+    }
+};
+
+template<typename>
+struct is_device_batch : std::false_type {};
+template<typename T, std::size_t N>
+struct is_device_batch<DeviceBatch<T, N>> : std::true_type {};
+template<typename B>
+inline constexpr bool is_device_batch_v = is_device_batch<std::decay_t<B>>::value;
+
+// Копія пакета на пристрої; копіювання ще може йти, тож host має жити до наступного очікування
+template<typename T, std::size_t N>
+DeviceBatch<T, N> to_device(Device& device, const VectorBatch<T, N>& host) {
+    DeviceBatch<T, N> result(device, host.size());
+    result.upload(host);
+    return result;
+}
+
+// Блокує до кінця копіювання, а отже й до кінця всіх команд, поставлених раніше
+template<typename T, std::size_t N>
+VectorBatch<T, N> to_host(const DeviceBatch<T, N>& batch) {
+    VectorBatch<T, N> result;
+    batch.download(result).wait_and_throw();
+    return result;
+}
+
+namespace detail {
+
+// Одне ядро на всі N * count елементів: out[i] = f(i), де i - плоский індекс блоку
+template<typename R, std::size_t N, typename F>
+DeviceBatch<R, N> launch(sycl::queue queue, std::size_t count, F f) {
+    DeviceBatch<R, N> result(queue, count);
+    R* out = result.data();
+    if (count > 0)
+        queue.parallel_for(sycl::range<1>(N * count), [=](sycl::id<1> i) { out[i[0]] = f(i[0]); });
+    return result;
+}
+
+} // namespace detail
+
+// Поелементні операції: тип результату Promote<T, U>, як у VectorBatch
+template<typename T, typename U, std::size_t N, typename Op>
+auto apply(const DeviceBatch<T, N>& a, const DeviceBatch<U, N>& b, Op op) {
+    using R = Promote<T, U>;
+    ::detail::check_batch_sizes(a.size(), b.size());
+    const T* x = a.data();
+    const U* y = b.data();
+    return detail::launch<R, N>(a.queue(), a.size(), [=](std::size_t i) { return static_cast<R>(op(x[i], y[i])); });
+}
+
+template<typename T, std::size_t N, typename U, typename Op>
+auto apply_scalar(const DeviceBatch<T, N>& a, const U& scalar, Op op) {
+    using R = Promote<T, U>;
+    using S = ::detail::scalar_storage_t<T, U>;
+    const S s = static_cast<S>(scalar);
+    const T* x = a.data();
+    return detail::launch<R, N>(a.queue(), a.size(), [=](std::size_t i) { return static_cast<R>(op(x[i], s)); });
+}
+
+template<typename T1, std::size_t N, typename U1, typename T2, typename U2>
+auto weighted_sum(const DeviceBatch<T1, N>& b1, const U1& alpha, const DeviceBatch<T2, N>& b2, const U2& beta) {
+    using R1 = std::common_type_t<T1, U1>;
+    using R2 = std::common_type_t<T2, U2>;
+    using R  = typename PromoteMultiple<R1, R2>::type;
+    ::detail::check_batch_sizes(b1.size(), b2.size());
+    const T1* x = b1.data();
+    const T2* y = b2.data();
+    return detail::launch<R, N>(b1.queue(), b1.size(), [=](std::size_t i) {
+        return static_cast<R>(alpha * x[i] + beta * y[i]);
+    });
+}
+
+namespace detail {
+
+template<typename Tuple, std::size_t... I>
+auto linear_combination_impl(const Tuple& args, std::index_sequence<I...>) {
+    using Types = std::decay_t<Tuple>;
+    constexpr std::size_t N = std::decay_t<std::tuple_element_t<0, Types>>::dimension;
+    static_assert(((std::decay_t<std::tuple_element_t<2 * I, Types>>::dimension == N) && ...),
+                  "vector dimensions must match");
+    using R = typename PromoteMultiple<typename std::decay_t<std::tuple_element_t<2 * I, Types>>::value_type...,
+                                       std::decay_t<std::tuple_element_t<2 * I + 1, Types>>...>::type;
+    const auto& first = std::get<0>(args);
+    (::detail::check_batch_sizes(first.size(), std::get<2 * I>(args).size()), ...);
+    const auto src = std::make_tuple(std::get<2 * I>(args).data()...);
+    const std::array<R, sizeof...(I)> coeff{static_cast<R>(std::get<2 * I + 1>(args))...};
+    return launch<R, N>(first.queue(), first.size(), [=](std::size_t i) {
+        R acc{};
+        ((acc = (I == 0) ? static_cast<R>(coeff[0] * static_cast<R>(std::get<0>(src)[i]))
+                         : simd::mul_add(coeff[I], static_cast<R>(std::get<I>(src)[i]), acc)), ...);
+        return acc;
+    });
+}
+
+} // namespace detail
+
+// Одним ядром без проміжних пакетів; формула і тип результату ті самі, що для VectorBatch
+template<typename B, typename... Args, std::enable_if_t<is_device_batch_v<B>, int> = 0>
+auto linear_combination(const B& first, const Args&... rest) {
+    static_assert(sizeof...(Args) % 2 == 1, "linear_combination expects (batch, coefficient) pairs");
+    return detail::linear_combination_impl(std::forward_as_tuple(first, rest...),
+                                           std::make_index_sequence<(sizeof...(Args) + 1) / 2>{});
+}
+
+// Сума всіх векторів: по одній редукції SYCL на стовпець, результат копіюється на хост.
+// Порядок додавання визначає пристрій, тож останні біти можуть відрізнятися від batch_sum
+template<typename T, std::size_t N>
+auto sum(const DeviceBatch<T, N>& batch) {
+    using R = Promote<T, T>;
+    Vector<R, N> result;
+    if (batch.empty())
+        return result;
+    sycl::queue queue = batch.queue();
+    R* partial = sycl::malloc_device<R>(N, queue);
+    if (!partial)
+        ::detail::raise_error<std::runtime_error>("gpu::sum: device allocation failed");
+    for (std::size_t c = 0; c < N; ++c) {
+        const T* col = batch.column(c);
+        queue.parallel_for(sycl::range<1>(batch.size()),
+                           sycl::reduction(partial + c, sycl::plus<R>(),
+                                           sycl::property::reduction::initialize_to_identity{}),
+                           [=](sycl::id<1> i, auto& s) { s += static_cast<R>(col[i[0]]); });
+    }
+    queue.memcpy(result.data(), partial, N * sizeof(R)).wait_and_throw();
+    sycl::free(partial, queue);
+    return result;
+}
+
+template<typename T, std::size_t N>
+template<typename U>
+DeviceBatch<U, N> DeviceBatch<T, N>::convert() const {
+    const T* x = data_;
+    return detail::launch<U, N>(queue_, size_, [=](std::size_t i) { return ::detail::convert_value<U>(x[i]); });
+}
+
+#endif // VECTOR_HAS_SYCL
+
+// ---- Engine: вибір між пристроєм і CPU за розміром пакета ----
+
+// Приймає й повертає звичайні VectorBatch. Великий пакет копіюється на пристрій, рахується
+// там і повертається; решта, а також усе без пристрою, йде через batch_* з config.cpu.
+// Для ланцюжка операцій краще тримати дані в DeviceBatch і копіювати лише кінцевий результат.
+class Engine {
+public:
+    explicit Engine(OffloadConfig config = {}) : config_(config) {
+#if defined(VECTOR_HAS_SYCL)
+#  if VECTOR_HAS_EXCEPTIONS
+        // Без GPU селектор кидає виняток, і Engine лишається суто процесорним
+        try {
+            device_ = std::make_unique<Device>(sycl::device(sycl::gpu_selector_v));
+        } catch (const sycl::exception&) {
+        }
+#  else
+        device_ = std::make_unique<Device>(sycl::device(sycl::gpu_selector_v));
+#  endif
+#endif
+    }
+
+#if defined(VECTOR_HAS_SYCL)
+    explicit Engine(Device device, OffloadConfig config = {})
+        : config_(config), device_(std::make_unique<Device>(std::move(device))) {}
+
+    Device* device() noexcept { return device_.get(); }
+#endif
+
+    const OffloadConfig& config() const noexcept { return config_; }
+
+    bool has_device() const noexcept {
+#if defined(VECTOR_HAS_SYCL)
+        return device_ != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    // Чи піде пакет з count векторів на пристрій
+    bool offloads(std::size_t count) const noexcept { return has_device() && count >= config_.min_size; }
+
+    template<typename T, typename U, std::size_t N, typename Op>
+    auto apply(const VectorBatch<T, N>& a, const VectorBatch<U, N>& b, Op op) const {
+#if defined(VECTOR_HAS_SYCL)
+        if (offloads(a.size())) {
+            ::detail::check_batch_sizes(a.size(), b.size());
+            VECTOR_TRACE_SPAN("gpu_apply");
+            return to_host(gpu::apply(to_device(*device_, a), to_device(*device_, b), op));
+        }
+#endif
+        return batch_apply(config_.cpu, a, b, op);
+    }
+
+    template<typename T, std::size_t N, typename U, typename Op>
+    auto apply_scalar(const VectorBatch<T, N>& a, const U& scalar, Op op) const {
+#if defined(VECTOR_HAS_SYCL)
+        if (offloads(a.size())) {
+            VECTOR_TRACE_SPAN("gpu_apply_scalar");
+            return to_host(gpu::apply_scalar(to_device(*device_, a), scalar, op));
+        }
+#endif
+        return batch_apply_scalar(config_.cpu, a, scalar, op);
+    }
+
+    template<typename T1, std::size_t N, typename U1, typename T2, typename U2>
+    auto weighted_sum(const VectorBatch<T1, N>& b1, const U1& alpha, const VectorBatch<T2, N>& b2, const U2& beta) const {
+#if defined(VECTOR_HAS_SYCL)
+        if (offloads(b1.size())) {
+            ::detail::check_batch_sizes(b1.size(), b2.size());
+            VECTOR_TRACE_SPAN("gpu_weighted_sum");
+            return to_host(gpu::weighted_sum(to_device(*device_, b1), alpha, to_device(*device_, b2), beta));
+        }
+#endif
+        return batch_weighted_sum(config_.cpu, b1, alpha, b2, beta);
+    }
+
+    template<typename T, std::size_t N>
+    auto sum(const VectorBatch<T, N>& batch) const {
+#if defined(VECTOR_HAS_SYCL)
+        if (offloads(batch.size())) {
+            VECTOR_TRACE_SPAN("gpu_sum");
+            return gpu::sum(to_device(*device_, batch));
+        }
+#endif
+        return batch_sum(config_.cpu, batch);
+    }
+
+    template<typename U, typename T, std::size_t N>
+    VectorBatch<U, N> convert(const VectorBatch<T, N>& batch) const {
+#if defined(VECTOR_HAS_SYCL)
+        if (offloads(batch.size())) {
+            VECTOR_TRACE_SPAN("gpu_convert");
+            return to_host(to_device(*device_, batch).template convert<U>());
+        }
+#endif
+        return batch.template convert<U>();
+    }
+
+private:
+    OffloadConfig config_;
+#if defined(VECTOR_HAS_SYCL)
+    std::unique_ptr<Device> device_;
+#endif
+};
+
+} // namespace gpu
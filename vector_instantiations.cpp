@@ -0,0 +1,14 @@
+// Явні інстанціації поширених типів для збірки з -DVECTOR_EXTERN_TEMPLATES=1:
+//   g++ -std=c++17 -O2 -c vector_instantiations.cpp
+// Об'єктний файл компонується з програмою, зібраною з тими самими прапорцями.
+#include "vector_all.hpp"
+
+#define VECTOR_INSTANTIATE(T, N) \
+    template class Vector<T, N>; \
+    template class VectorBatch<T, N>;
+VECTOR_FOR_EACH_INSTANCE(VECTOR_INSTANTIATE)
+#undef VECTOR_INSTANTIATE
+
+#define VECTOR_INSTANTIATE_DYN(T) template class DynVector<T>;
+VECTOR_FOR_EACH_INSTANCE_TYPE(VECTOR_INSTANTIATE_DYN)
+#undef VECTOR_INSTANTIATE_DYN
@@ -0,0 +1,518 @@
+// Двійковий і текстовий ввід/вивід векторів
+#pragma once
+
+#include "vector_batch.hpp"
+#include <charconv>
+#include <fstream>
+#include <istream>
+#include <string_view>
+#include <system_error>
+
+// ---- Двійковий формат: заголовок + вирівняний сирий масив, читання через mmap ----
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define VECTOR_HAS_MMAP 1
+#endif
+
+enum class VectorFileLayout : std::uint32_t { aos = 0, soa = 1 };
+
+// Заголовок займає рівно 64 байти; payload_offset кратний payload_alignment.
+// endian_tag записується в порядку байтів машини-записувача і на читанні має
+// збігатися з рідним, інакше дані без перетворення не прочитати.
+struct VectorFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t type_code;
+    std::uint32_t element_size;
+    std::uint32_t endian_tag;
+    std::uint64_t dimension;
+    std::uint64_t count;
+    std::uint64_t column_stride;   // для soa: відстань між стовпцями в елементах
+    std::uint32_t layout;
+    std::uint32_t reserved;
+    std::uint64_t payload_offset;
+};
+
+static_assert(sizeof(VectorFileHeader) == 64, "VectorFileHeader must stay 64 bytes");
+
+namespace detail {
+
+inline constexpr char vector_file_magic[8] = {'V', 'E', 'C', 'B', 'I', 'N', '\0', '\0'};
+inline constexpr std::uint32_t vector_file_version = 1;
+inline constexpr std::uint32_t vector_file_endian_tag = 0x01020304u;
+inline constexpr std::size_t vector_file_alignment = 64;
+
+// Код типу: вид (f - дійсний, i - знаковий, u - беззнаковий) у старшому байті, розмір - у молодшому
+template<typename T>
+constexpr std::uint32_t vector_file_type_code() {
+    static_assert(std::is_arithmetic_v<T>, "binary vector files hold arithmetic types only");
+    constexpr std::uint32_t kind = std::is_floating_point_v<T> ? 'f' : (std::is_signed_v<T> ? 'i' : 'u');
+    return (kind << 8) | static_cast<std::uint32_t>(sizeof(T));
+}
+
+template<typename T>
+constexpr std::size_t vector_file_column_stride(std::size_t count) {
+    constexpr std::size_t per_line = vector_file_alignment / sizeof(T);
+    return per_line == 0 ? count : (count + per_line - 1) / per_line * per_line;
+}
+
+[[noreturn]] VECTOR_COLD inline void throw_vector_file_error(const std::string& path, const char* what) {
+    raise_error<std::runtime_error>(("binary vector file '" + path + "': " + what).c_str());
+}
+
+template<typename T, std::size_t N>
+VectorFileHeader make_vector_file_header(std::size_t count, VectorFileLayout layout) {
+    VectorFileHeader h{};
+    std::memcpy(h.magic, vector_file_magic, sizeof h.magic);
+    h.version = vector_file_version;
+    h.type_code = vector_file_type_code<T>();
+    h.element_size = sizeof(T);
+    h.endian_tag = vector_file_endian_tag;
+    h.dimension = N;
+    h.count = count;
+    h.column_stride = layout == VectorFileLayout::soa ? vector_file_column_stride<T>(count) : 0;
+    h.layout = static_cast<std::uint32_t>(layout);
+    h.payload_offset = vector_file_alignment;
+    return h;
+}
+
+inline void write_vector_file_bytes(std::ofstream& out, const std::string& path, const void* p, std::size_t bytes) {
+    if (!out.write(static_cast<const char*>(p), static_cast<std::streamsize>(bytes)))
+        throw_vector_file_error(path, "write failed");
+}
+
+} // namespace detail
+
+// Масив векторів записується як є (N елементів поспіль на вектор)
+template<typename T, std::size_t N>
+void write_vector_file(const std::string& path, const Vector<T, N>* vectors, std::size_t count) {
+    static_assert(sizeof(Vector<T, N>) == N * sizeof(T), "Vector<T, N> must have no padding");
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        detail::throw_vector_file_error(path, "cannot open for writing");
+    const VectorFileHeader h = detail::make_vector_file_header<T, N>(count, VectorFileLayout::aos);
+    detail::write_vector_file_bytes(out, path, &h, sizeof h);
+    detail::write_vector_file_bytes(out, path, vectors, count * sizeof(Vector<T, N>));
+}
+
+template<typename T, std::size_t N>
+void write_vector_file(const std::string& path, const std::vector<Vector<T, N>>& vectors) {
+    write_vector_file(path, vectors.data(), vectors.size());
+}
+
+// Пакет записується стовпцями; кожен стовпець доповнюється нулями до 64 байт
+template<typename T, std::size_t N>
+void write_vector_file(const std::string& path, const VectorBatch<T, N>& batch) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        detail::throw_vector_file_error(path, "cannot open for writing");
+    const VectorFileHeader h = detail::make_vector_file_header<T, N>(batch.size(), VectorFileLayout::soa);
+    detail::write_vector_file_bytes(out, path, &h, sizeof h);
+    const std::vector<T> padding(h.column_stride - batch.size(), T{});
+    for (std::size_t c = 0; c < N; ++c) {
+        detail::write_vector_file_bytes(out, path, batch.column(c), batch.size() * sizeof(T));
+        detail::write_vector_file_bytes(out, path, padding.data(), padding.size() * sizeof(T));
+    }
+}
+
+// Файл, відображений у пам'ять лише для читання. Для aos дані доступні як
+// масив const Vector<T, N> без копіювання; row(i) працює для обох форматів.
+// Без mmap (наприклад, у Windows) файл читається у вирівняний буфер.
+template<typename T, std::size_t N>
+class MappedVectorFile {
+public:
+    using value_type = Vector<T, N>;
+    using row_view = VectorView<const T, N, dynamic_stride>;
+
+    explicit MappedVectorFile(const std::string& path) {
+        static_assert(sizeof(Vector<T, N>) == N * sizeof(T), "Vector<T, N> must have no padding");
+        open(path);
+#if VECTOR_HAS_EXCEPTIONS
+        try {
+            validate(path);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+#else
+        validate(path);
+#endif
+    }
+
+    MappedVectorFile(const MappedVectorFile&) = delete;
+    MappedVectorFile& operator=(const MappedVectorFile&) = delete;
+
+    MappedVectorFile(MappedVectorFile&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)),
+          length_(std::exchange(other.length_, 0)),
+          buffer_(std::move(other.buffer_)),
+          header_(other.header_) {}
+
+    MappedVectorFile& operator=(MappedVectorFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            base_ = std::exchange(other.base_, nullptr);
+            length_ = std::exchange(other.length_, 0);
+            buffer_ = std::move(other.buffer_);
+            header_ = other.header_;
+        }
+        return *this;
+    }
+
+    ~MappedVectorFile() { unmap(); }
+
+    std::size_t size() const noexcept { return static_cast<std::size_t>(header_.count); }
+    bool empty() const noexcept { return size() == 0; }
+    VectorFileLayout layout() const noexcept { return static_cast<VectorFileLayout>(header_.layout); }
+    const VectorFileHeader& header() const noexcept { return header_; }
+
+    // Лише для aos
+    const Vector<T, N>* data() const {
+        if (layout() != VectorFileLayout::aos)
+            detail::raise_error<std::logic_error>("MappedVectorFile: data() requires the aos layout");
+        return reinterpret_cast<const Vector<T, N>*>(payload());
+    }
+    const Vector<T, N>* begin() const { return data(); }
+    const Vector<T, N>* end() const { return data() + size(); }
+    const Vector<T, N>& operator[](std::size_t i) const { return data()[i]; }
+
+    // Лише для soa
+    const T* column(std::size_t c) const {
+        if (layout() != VectorFileLayout::soa)
+            detail::raise_error<std::logic_error>("MappedVectorFile: column() requires the soa layout");
+        return payload() + c * header_.column_stride;
+    }
+
+    row_view row(std::size_t i) const noexcept {
+        if (layout() == VectorFileLayout::soa)
+            return row_view(payload() + i, static_cast<std::ptrdiff_t>(header_.column_stride));
+        return row_view(payload() + i * N, 1);
+    }
+
+    VectorBatch<T, N> to_batch() const {
+        VectorBatch<T, N> batch(size());
+        for (std::size_t c = 0; c < N; ++c) {
+            T* out = batch.column(c);
+            for (std::size_t i = 0; i < size(); ++i)
+                out[i] = row(i).at_unchecked(c);
+        }
+        return batch;
+    }
+
+private:
+    const unsigned char* base_ = nullptr;
+    std::size_t length_ = 0;
+    std::vector<unsigned char, AlignedAllocator<unsigned char, detail::vector_file_alignment>> buffer_;
+    VectorFileHeader header_{};
+
+    const T* payload() const noexcept {
+        return reinterpret_cast<const T*>(base_ + header_.payload_offset);
+    }
+
+    void open(const std::string& path) {
+#if defined(VECTOR_HAS_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            detail::throw_vector_file_error(path, "cannot open for reading");
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            detail::throw_vector_file_error(path, "cannot stat");
+        }
+        length_ = static_cast<std::size_t>(st.st_size);
+        void* p = length_ == 0 ? MAP_FAILED : ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            length_ = 0;
+            detail::throw_vector_file_error(path, "mmap failed");
+        }
+        base_ = static_cast<const unsigned char*>(p);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            detail::throw_vector_file_error(path, "cannot open for reading");
+        length_ = static_cast<std::size_t>(in.tellg());
+        buffer_.resize(length_);
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(length_)))
+            detail::throw_vector_file_error(path, "read failed");
+        base_ = buffer_.data();
+#endif
+    }
+
+    void unmap() noexcept {
+#if defined(VECTOR_HAS_MMAP)
+        if (base_ != nullptr)
+            ::munmap(const_cast<unsigned char*>(base_), length_);
+#endif
+        base_ = nullptr;
+        length_ = 0;
+        buffer_.clear();
+    }
+
+    void validate(const std::string& path) {
+        if (length_ < sizeof header_)
+            detail::throw_vector_file_error(path, "truncated header");
+        std::memcpy(&header_, base_, sizeof header_);
+        if (std::memcmp(header_.magic, detail::vector_file_magic, sizeof header_.magic) != 0)
+            detail::throw_vector_file_error(path, "not a binary vector file");
+        if (header_.version != detail::vector_file_version)
+            detail::throw_vector_file_error(path, "unsupported version");
+        if (header_.endian_tag != detail::vector_file_endian_tag)
+            detail::throw_vector_file_error(path, "endianness mismatch");
+        if (header_.type_code != detail::vector_file_type_code<T>() || header_.element_size != sizeof(T))
+            detail::throw_vector_file_error(path, "element type mismatch");
+        if (header_.dimension != N)
+            detail::throw_vector_file_error(path, "dimension mismatch");
+        if (header_.layout > static_cast<std::uint32_t>(VectorFileLayout::soa) ||
+            header_.payload_offset % detail::vector_file_alignment != 0)
+            detail::throw_vector_file_error(path, "corrupt header");
+        if (layout() == VectorFileLayout::soa && header_.column_stride < header_.count)
+            detail::throw_vector_file_error(path, "corrupt header");
+        // Порівняння діленням: добуток count * N з підробленого заголовка може переповнитися
+        const std::uint64_t rows = layout() == VectorFileLayout::soa ? header_.column_stride : header_.count;
+        if (header_.payload_offset > length_ ||
+            rows > (length_ - header_.payload_offset) / sizeof(T) / std::max<std::size_t>(N, 1))
+            detail::throw_vector_file_error(path, "truncated payload");
+    }
+};
+
+// ---- Текстовий ввід/вивід без локалі: std::from_chars / std::to_chars ----
+
+// Результат розбору: ec == std::errc{} - успіх; інакше ptr вказує на місце
+// помилки, а component - на номер компоненти, яку не вдалося прочитати.
+template<typename T, std::size_t N>
+struct VectorParseResult {
+    Vector<T, N> value;
+    const char* ptr;
+    std::errc ec;
+    std::size_t component;
+
+    explicit operator bool() const noexcept { return ec == std::errc{}; }
+};
+
+namespace detail {
+
+constexpr bool is_text_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+constexpr const char* skip_text_space(const char* p, const char* last) noexcept {
+    while (p != last && is_text_space(*p))
+        ++p;
+    return p;
+}
+
+// Роздільник між компонентами: пробіли і не більше однієї коми чи крапки з комою
+constexpr const char* skip_text_separator(const char* p, const char* last) noexcept {
+    p = skip_text_space(p, last);
+    if (p != last && (*p == ',' || *p == ';'))
+        p = skip_text_space(p + 1, last);
+    return p;
+}
+
+template<typename T>
+std::from_chars_result parse_scalar(const char* first, const char* last, T& value) {
+    if (first != last && *first == '+')
+        ++first;
+    if constexpr (std::is_floating_point_v<T>)
+        return std::from_chars(first, last, value, std::chars_format::general);
+    else
+        return std::from_chars(first, last, value);
+}
+
+// Розбирає один вектор з [first, last), не вимагаючи дочитати до кінця
+template<typename T, std::size_t N>
+VectorParseResult<T, N> parse_vector_prefix(const char* first, const char* last) {
+    VectorParseResult<T, N> r{Vector<T, N>(), first, std::errc{}, 0};
+    const char* p = skip_text_space(first, last);
+    const bool bracketed = p != last && *p == '[';
+    if (bracketed)
+        p = skip_text_space(p + 1, last);
+    for (; r.component < N; ++r.component) {
+        if (r.component > 0)
+            p = skip_text_separator(p, last);
+        const auto [next, ec] = parse_scalar(p, last, r.value.at_unchecked(r.component));
+        if (ec != std::errc{}) {
+            r.ptr = p;
+            r.ec = ec;
+            return r;
+        }
+        p = next;
+    }
+    if (bracketed) {
+        p = skip_text_space(p, last);
+        if (p == last || *p != ']') {
+            r.ptr = p;
+            r.ec = std::errc::invalid_argument;
+            return r;
+        }
+        ++p;
+    }
+    r.ptr = p;
+    return r;
+}
+
+} // namespace detail
+
+// Приймає "[1, 2, 3]" (як друкує operator<<), "1,2,3", "1;2;3" і "1 2 3".
+// Після вектора дозволені лише пробіли.
+template<typename T, std::size_t N>
+VectorParseResult<T, N> parse_vector(std::string_view text) {
+    const char* last = text.data() + text.size();
+    VectorParseResult<T, N> r = detail::parse_vector_prefix<T, N>(text.data(), last);
+    if (r) {
+        const char* rest = detail::skip_text_space(r.ptr, last);
+        if (rest != last) {
+            r.ptr = rest;
+            r.ec = std::errc::invalid_argument;
+        } else {
+            r.ptr = last;
+        }
+    }
+    return r;
+}
+
+// Пише "[a, b, c]" у [buf, buf + capacity) без завершального нуля. Дійсні числа -
+// найкоротшим записом, що читається назад без втрат. За нестачі місця
+// ec == std::errc::value_too_large, вміст буфера тоді не визначений.
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+std::to_chars_result format_vector(char* buf, std::size_t capacity, const E& v) {
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    char* p = buf;
+    char* const last = buf + capacity;
+    if (p == last)
+        return {p, std::errc::value_too_large};
+    *p++ = '[';
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i > 0) {
+            if (last - p < 2)
+                return {p, std::errc::value_too_large};
+            *p++ = ',';
+            *p++ = ' ';
+        }
+        const auto [next, ec] = std::to_chars(p, last, detail::element(v, i));
+        if (ec != std::errc{})
+            return {next, ec};
+        p = next;
+    }
+    if (p == last)
+        return {p, std::errc::value_too_large};
+    *p++ = ']';
+    return {p, std::errc{}};
+}
+
+// Дописує вектор у кінець рядка (зручно для буферизованого виводу пачками)
+template<typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+void format_vector(std::string& out, const E& v) {
+    constexpr std::size_t N = std::decay_t<E>::dimension;
+    // 32 символи вміщають будь-яке double чи 64-бітне ціле, ще 2 - роздільник
+    const std::size_t old_size = out.size();
+    out.resize(old_size + 2 + N * 34);
+    const auto r = format_vector(out.data() + old_size, out.size() - old_size, v);
+    out.resize(static_cast<std::size_t>(r.ptr - out.data()));
+}
+
+// Підсумок розбору по рядках; номери рядків починаються з 1
+struct LineParseStats {
+    std::size_t lines = 0;
+    std::size_t parsed = 0;
+    std::size_t failed = 0;
+    std::size_t first_error_line = 0;
+    std::errc first_error{};
+};
+
+namespace detail {
+
+template<typename T, std::size_t N, typename Sink>
+void parse_vector_line(std::string_view line, LineParseStats& stats, Sink& sink) {
+    ++stats.lines;
+    const char* last = line.data() + line.size();
+    const char* p = skip_text_space(line.data(), last);
+    if (p == last || *p == '#')
+        return;
+    const VectorParseResult<T, N> r = parse_vector<T, N>(std::string_view(p, static_cast<std::size_t>(last - p)));
+    if (r) {
+        ++stats.parsed;
+        sink(r.value);
+        return;
+    }
+    if (stats.failed++ == 0) {
+        stats.first_error_line = stats.lines;
+        stats.first_error = r.ec;
+    }
+}
+
+} // namespace detail
+
+// Один вектор на рядок; порожні рядки і рядки з '#' пропускаються, а хибні
+// рахуються в stats.failed і не зупиняють розбір. sink(const Vector<T, N>&).
+template<typename T, std::size_t N, typename Sink>
+LineParseStats parse_vector_lines(std::string_view text, Sink&& sink) {
+    LineParseStats stats;
+    while (!text.empty()) {
+        const std::size_t eol = text.find('\n');
+        detail::parse_vector_line<T, N>(text.substr(0, eol), stats, sink);
+        if (eol == std::string_view::npos)
+            break;
+        text.remove_prefix(eol + 1);
+    }
+    return stats;
+}
+
+// Читає потік блоками по chunk_bytes і розбирає лише повні рядки,
+// тож файли на гігабайти не потрібно тримати в пам'яті цілком
+template<typename T, std::size_t N, typename Sink>
+LineParseStats parse_vector_lines(std::istream& in, Sink&& sink, std::size_t chunk_bytes = 1 << 20) {
+    LineParseStats stats;
+    std::string buffer;
+    std::size_t carried = 0;
+    while (in) {
+        buffer.resize(carried + chunk_bytes);
+        in.read(buffer.data() + carried, static_cast<std::streamsize>(chunk_bytes));
+        const std::size_t filled = carried + static_cast<std::size_t>(in.gcount());
+        std::string_view text(buffer.data(), filled);
+        const std::size_t last_eol = text.rfind('\n');
+        if (last_eol == std::string_view::npos) {
+            carried = filled;
+            continue;
+        }
+        // Разом з останнім '\n': інакше порожній рядок перед межею блоку не рахується
+        const LineParseStats part = parse_vector_lines<T, N>(text.substr(0, last_eol + 1), sink);
+        if (stats.failed == 0 && part.failed > 0) {
+            stats.first_error_line = stats.lines + part.first_error_line;
+            stats.first_error = part.first_error;
+        }
+        stats.lines += part.lines;
+        stats.parsed += part.parsed;
+        stats.failed += part.failed;
+        carried = filled - last_eol - 1;
+        std::memmove(buffer.data(), buffer.data() + last_eol + 1, carried);
+    }
+    if (carried > 0) {
+        LineParseStats tail;
+        detail::parse_vector_line<T, N>(std::string_view(buffer.data(), carried), tail, sink);
+        if (stats.failed == 0 && tail.failed > 0) {
+            stats.first_error_line = stats.lines + 1;
+            stats.first_error = tail.first_error;
+        }
+        stats.lines += tail.lines;
+        stats.parsed += tail.parsed;
+        stats.failed += tail.failed;
+    }
+    return stats;
+}
+
+template<typename T, std::size_t N>
+LineParseStats parse_vector_lines(std::string_view text, VectorBatch<T, N>& out) {
+    return parse_vector_lines<T, N>(text, [&out](const Vector<T, N>& v) { out.push_back(v); });
+}
+
+template<typename T, std::size_t N>
+LineParseStats parse_vector_lines(std::istream& in, VectorBatch<T, N>& out) {
+    return parse_vector_lines<T, N>(in, [&out](const Vector<T, N>& v) { out.push_back(v); });
+}
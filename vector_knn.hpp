@@ -0,0 +1,441 @@
+// Пошук найближчих сусідів: KD-дерево для малих N і SIMD-перебір стовпців VectorBatch
+#pragma once
+
+#include "vector_parallel.hpp"
+
+// ---- Найближчі сусіди: метрики, обмежена купа top-k, KdTree, BruteForceIndex ----
+
+// l2 - евклідова відстань, l1 - сума модулів, cosine - 1 - cos кута.
+// Для cosine нульові вектори не мають напрямку і в результати не потрапляють.
+enum class Metric {
+    l2,
+    l1,
+    cosine
+};
+
+template<typename D>
+struct Neighbor {
+    std::size_t index;   // номер точки у вхідному наборі
+    D distance;
+};
+
+namespace detail {
+
+// k найкращих кандидатів у max-купі: вершина - найгірший з них, тож перевірка
+// нового кандидата коштує одне порівняння. Рівні відстані впорядковує менший номер.
+template<typename D>
+class TopK {
+public:
+    explicit TopK(std::size_t k) : k_(k) { heap_.reserve(k); }
+
+    // Межа, гірші за яку кандидати вже не потрібні
+    D bound() const noexcept {
+        if (k_ == 0)
+            return -std::numeric_limits<D>::infinity();
+        return heap_.size() < k_ ? std::numeric_limits<D>::infinity() : heap_.front().distance;
+    }
+
+    void push(std::size_t index, D distance) {
+        if (heap_.size() < k_) {
+            if (!(distance < std::numeric_limits<D>::infinity()))
+                return;
+            heap_.push_back({index, distance});
+            std::push_heap(heap_.begin(), heap_.end(), less);
+        } else if (k_ > 0 && less({index, distance}, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), less);
+            heap_.back() = {index, distance};
+            std::push_heap(heap_.begin(), heap_.end(), less);
+        }
+    }
+
+    // Від найближчого до найдальшого
+    std::vector<Neighbor<D>> take_sorted() {
+        std::sort_heap(heap_.begin(), heap_.end(), less);
+        return std::move(heap_);
+    }
+
+private:
+    static bool less(const Neighbor<D>& a, const Neighbor<D>& b) noexcept {
+        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+    }
+
+    std::size_t k_;
+    std::vector<Neighbor<D>> heap_;
+};
+
+// Внесок однієї компоненти у відстань: (x - q)^2, |x - q| або x * q для cosine
+template<Metric M, typename D>
+D distance_term(D x, D q, D acc) {
+    if constexpr (M == Metric::l2)
+        return acc + (x - q) * (x - q);
+    else if constexpr (M == Metric::l1)
+        return acc + std::abs(x - q);
+    else
+        return acc + x * q;
+}
+
+template<Metric M, typename P, typename V>
+V packet_distance_term(V x, V q, V acc) {
+    if constexpr (M == Metric::l2) {
+        const V d = P::sub(x, q);
+        return P::fma(d, d, acc);
+    } else if constexpr (M == Metric::l1) {
+        const V d = P::sub(x, q);
+        return P::add(acc, P::max(d, P::sub(P::broadcast(0), d)));
+    } else {
+        return P::fma(x, q, acc);
+    }
+}
+
+template<Metric M, typename T, typename D>
+constexpr bool packet_distance_v = std::is_same_v<T, D> && simd::Packet<T>::enabled && simd::Packet<T>::has_mul &&
+                                   (M != Metric::l1 || simd::Packet<T>::has_minmax);
+
+// dist[i] для n точок зі стовпців cols[c]. До 16 компонент - один прохід з акумулятором
+// у регістрі; більше - стовпець за стовпцем, щоб не читати забагато потоків пам'яті разом.
+template<Metric M, std::size_t N, typename T, typename D>
+void distance_block(const T* const* cols, const D* q, D* dist, std::size_t n) {
+    if constexpr (N <= 16) {
+        std::size_t i = 0;
+        if constexpr (packet_distance_v<M, T, D>) {
+            using P = simd::Packet<T>;
+            typename P::type vq[N];
+            for (std::size_t c = 0; c < N; ++c)
+                vq[c] = P::broadcast(q[c]);
+            for (const std::size_t full = n - n % P::width; i < full; i += P::width) {
+                auto a = P::broadcast(0);
+                for (std::size_t c = 0; c < N; ++c)
+                    a = packet_distance_term<M, P>(P::load(cols[c] + i), vq[c], a);
+                P::store(dist + i, a);
+            }
+        }
+        for (; i < n; ++i) {
+            D a{};
+            for (std::size_t c = 0; c < N; ++c)
+                a = distance_term<M>(static_cast<D>(cols[c][i]), q[c], a);
+            dist[i] = a;
+        }
+    } else {
+        std::fill(dist, dist + n, D{});
+        for (std::size_t c = 0; c < N; ++c) {
+            std::size_t i = 0;
+            if constexpr (packet_distance_v<M, T, D>) {
+                using P = simd::Packet<T>;
+                const auto vq = P::broadcast(q[c]);
+                for (const std::size_t full = n - n % P::width; i < full; i += P::width)
+                    P::store(dist + i, packet_distance_term<M, P>(P::load(cols[c] + i), vq, P::load(dist + i)));
+            }
+            for (; i < n; ++i)
+                dist[i] = distance_term<M>(static_cast<D>(cols[c][i]), q[c], dist[i]);
+        }
+    }
+}
+
+template<typename D, typename E>
+Vector<D, std::decay_t<E>::dimension> query_point(const E& query) {
+    Vector<D, std::decay_t<E>::dimension> q;
+    for (std::size_t c = 0; c < q.size(); ++c)
+        q.at_unchecked(c) = static_cast<D>(element(query, c));
+    return q;
+}
+
+// Відстань для користувача з внутрішньої: l2 зберігається квадратом
+template<typename D>
+D finish_distance(Metric metric, D d) {
+    return metric == Metric::l2 ? std::sqrt(d) : d;
+}
+
+} // namespace detail
+
+// Перебір усіх точок пакета блоками, що лишаються в кеші L1: кожна компонента блоку - один
+// SIMD-прохід по стовпцю без тимчасових векторів. Пакетні запити ділять один прохід по
+// блоку точок між query_block запитами. Добре для великих N, коли KD-дерево не відсікає.
+template<typename T, std::size_t N>
+class BruteForceIndex {
+    using D = detail::norm_result_t<T>;
+
+public:
+    using value_type = T;
+    using distance_type = D;
+    static constexpr std::size_t dimension = N;
+    static constexpr std::size_t query_block = 16;
+
+    explicit BruteForceIndex(VectorBatch<T, N> points, Metric metric = Metric::l2)
+        : points_(std::move(points)), metric_(metric) {
+        if (metric_ == Metric::cosine) {
+            norms_.assign(points_.size(), D{});
+            for (std::size_t c = 0; c < N; ++c) {
+                const T* col = points_.column(c);
+                for (std::size_t i = 0; i < points_.size(); ++i)
+                    norms_[i] += static_cast<D>(col[i]) * static_cast<D>(col[i]);
+            }
+            for (D& n : norms_)
+                n = std::sqrt(n);
+        }
+    }
+
+    std::size_t size() const noexcept { return points_.size(); }
+    Metric metric() const noexcept { return metric_; }
+    const VectorBatch<T, N>& points() const noexcept { return points_; }
+
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    std::vector<Neighbor<D>> nearest(const E& query, std::size_t k) const {
+        VECTOR_COUNT_CALL(instrumentation::Op::reduce, N * size());
+        const Vector<D, N> q = detail::query_point<D>(query);
+        detail::TopK<D> top(k);
+        scan(&q, &top, 1);
+        return finish(top);
+    }
+
+    // out[i] = nearest(queries[i], k) для i у [begin, end)
+    template<typename U>
+    void search_range(const VectorBatch<U, N>& queries, std::size_t begin, std::size_t end, std::size_t k,
+                      std::vector<Neighbor<D>>* out) const {
+        for (std::size_t b = begin; b < end; b += query_block) {
+            const std::size_t count = std::min(query_block, end - b);
+            Vector<D, N> q[query_block];
+            std::vector<detail::TopK<D>> tops(count, detail::TopK<D>(k));
+            for (std::size_t j = 0; j < count; ++j)
+                q[j] = detail::query_point<D>(queries[b + j]);
+            scan(q, tops.data(), count);
+            for (std::size_t j = 0; j < count; ++j)
+                out[b + j] = finish(tops[j]);
+        }
+    }
+
+private:
+    // Блок точок такого розміру, щоб стовпці блоку і відстані вміщалися в 32 КБ
+    static constexpr std::size_t block_points() {
+        constexpr std::size_t b = (32 * 1024) / (N * sizeof(T) + sizeof(D));
+        return b < 64 ? 64 : b - b % 64;
+    }
+
+    void scan(const Vector<D, N>* queries, detail::TopK<D>* tops, std::size_t count) const {
+        constexpr std::size_t block = block_points();
+        std::vector<D> dist(block);
+        for (std::size_t begin = 0; begin < points_.size(); begin += block) {
+            const std::size_t n = std::min(block, points_.size() - begin);
+            const T* cols[N];
+            for (std::size_t c = 0; c < N; ++c)
+                cols[c] = points_.column(c) + begin;
+            for (std::size_t j = 0; j < count; ++j) {
+                const Vector<D, N>& q = queries[j];
+                if (metric_ == Metric::l2) {
+                    detail::distance_block<Metric::l2, N>(cols, q.data(), dist.data(), n);
+                } else if (metric_ == Metric::l1) {
+                    detail::distance_block<Metric::l1, N>(cols, q.data(), dist.data(), n);
+                } else {
+                    detail::distance_block<Metric::cosine, N>(cols, q.data(), dist.data(), n);
+                    finish_cosine(q, begin, n, dist.data());
+                }
+                // Межа оновлюється лише після вставки, тож звичайний крок - одне порівняння
+                detail::TopK<D>& top = tops[j];
+                D bound = top.bound();
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (!(bound < dist[i])) {
+                        top.push(begin + i, dist[i]);
+                        bound = top.bound();
+                    }
+                }
+            }
+        }
+    }
+
+    void finish_cosine(const Vector<D, N>& q, std::size_t begin, std::size_t n, D* dist) const {
+        const D qn = norm(q);
+        for (std::size_t i = 0; i < n; ++i) {
+            const D pn = norms_[begin + i];
+            dist[i] = (pn == D{} || qn == D{}) ? std::numeric_limits<D>::infinity()
+                                               : D(1) - dist[i] / (pn * qn);
+        }
+    }
+
+    std::vector<Neighbor<D>> finish(detail::TopK<D>& top) const {
+        std::vector<Neighbor<D>> result = top.take_sorted();
+        for (Neighbor<D>& r : result)
+            r.distance = detail::finish_distance(metric_, r.distance);
+        return result;
+    }
+
+    VectorBatch<T, N> points_;
+    Metric metric_;
+    std::vector<D> norms_;
+};
+
+// KD-дерево для малих N (2-8): точки переставлені в масиві так, що піддерево - неперервний
+// відрізок, розбиття - медіана за віссю найбільшого розкиду, листки до leaf_size точок
+// перебираються підряд. Гілка відкидається, коли відстань до площини розбиття вже гірша за
+// k-го кандидата. Для cosine дерево будується над нормованими точками: 1 - cos = |a - b|^2 / 2.
+template<typename T, std::size_t N>
+class KdTree {
+    static_assert(N <= 256, "KdTree stores split axes in one byte; use BruteForceIndex for N > 256");
+
+    using D = detail::norm_result_t<T>;
+
+public:
+    using value_type = T;
+    using distance_type = D;
+    static constexpr std::size_t dimension = N;
+    static constexpr std::size_t query_block = 64;
+
+    explicit KdTree(const VectorBatch<T, N>& points, Metric metric = Metric::l2, std::size_t leaf_size = 8)
+        : metric_(metric), leaf_size_(leaf_size == 0 ? 1 : leaf_size) {
+        std::vector<Vector<D, N>> source(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            source[i] = detail::query_point<D>(points[i]);
+        build(source);
+    }
+
+    template<std::size_t A>
+    KdTree(const Vector<T, N, A>* points, std::size_t count, Metric metric = Metric::l2, std::size_t leaf_size = 8)
+        : metric_(metric), leaf_size_(leaf_size == 0 ? 1 : leaf_size) {
+        std::vector<Vector<D, N>> source(count);
+        for (std::size_t i = 0; i < count; ++i)
+            source[i] = detail::query_point<D>(points[i]);
+        build(source);
+    }
+
+    // Без нульових векторів для cosine
+    std::size_t size() const noexcept { return points_.size(); }
+    Metric metric() const noexcept { return metric_; }
+
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    std::vector<Neighbor<D>> nearest(const E& query, std::size_t k) const {
+        detail::TopK<D> top(k);
+        search(prepare(detail::query_point<D>(query)), top);
+        return finish(top);
+    }
+
+    template<typename U>
+    void search_range(const VectorBatch<U, N>& queries, std::size_t begin, std::size_t end, std::size_t k,
+                      std::vector<Neighbor<D>>* out) const {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = nearest(queries[i], k);
+    }
+
+private:
+    void build(std::vector<Vector<D, N>>& source) {
+        ids_.reserve(source.size());
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            if (metric_ == Metric::cosine) {
+                if (squared_norm(source[i]) == D{})
+                    continue;
+                source[i] = normalize(source[i]);
+            }
+            ids_.push_back(i);
+        }
+        split_.assign(ids_.size(), 0);
+        build_range(source, 0, ids_.size());
+        points_.resize(ids_.size());
+        for (std::size_t i = 0; i < ids_.size(); ++i)
+            points_[i] = source[ids_[i]];
+    }
+
+    void build_range(const std::vector<Vector<D, N>>& source, std::size_t lo, std::size_t hi) {
+        if (hi - lo <= leaf_size_)
+            return;
+        std::size_t axis = 0;
+        D widest = D(-1);
+        for (std::size_t c = 0; c < N; ++c) {
+            D low = source[ids_[lo]].at_unchecked(c), high = low;
+            for (std::size_t i = lo + 1; i < hi; ++i) {
+                const D x = source[ids_[i]].at_unchecked(c);
+                low = std::min(low, x);
+                high = std::max(high, x);
+            }
+            if (high - low > widest) {
+                widest = high - low;
+                axis = c;
+            }
+        }
+        const std::size_t mid = lo + (hi - lo) / 2;
+        std::nth_element(ids_.begin() + lo, ids_.begin() + mid, ids_.begin() + hi,
+                         [&](std::size_t a, std::size_t b) {
+                             return source[a].at_unchecked(axis) < source[b].at_unchecked(axis);
+                         });
+        split_[mid] = static_cast<std::uint8_t>(axis);
+        build_range(source, lo, mid);
+        build_range(source, mid + 1, hi);
+    }
+
+    Vector<D, N> prepare(const Vector<D, N>& q) const {
+        return metric_ == Metric::cosine ? Vector<D, N>(normalize(q)) : q;
+    }
+
+    D distance(const Vector<D, N>& p, const Vector<D, N>& q) const {
+        D d{};
+        if (metric_ == Metric::l1) {
+            for (std::size_t c = 0; c < N; ++c)
+                d += std::abs(p.at_unchecked(c) - q.at_unchecked(c));
+        } else {
+            for (std::size_t c = 0; c < N; ++c) {
+                const D x = p.at_unchecked(c) - q.at_unchecked(c);
+                d += x * x;
+            }
+        }
+        return d;
+    }
+
+    void search(const Vector<D, N>& q, detail::TopK<D>& top) const {
+        if (metric_ == Metric::cosine && squared_norm(q) == D{})
+            return;
+        descend(q, top, 0, points_.size());
+    }
+
+    void descend(const Vector<D, N>& q, detail::TopK<D>& top, std::size_t lo, std::size_t hi) const {
+        if (hi - lo <= leaf_size_) {
+            for (std::size_t i = lo; i < hi; ++i)
+                top.push(ids_[i], distance(points_[i], q));
+            return;
+        }
+        const std::size_t mid = lo + (hi - lo) / 2;
+        const std::size_t axis = split_[mid];
+        const D diff = q.at_unchecked(axis) - points_[mid].at_unchecked(axis);
+        top.push(ids_[mid], distance(points_[mid], q));
+        if (diff < D{}) {
+            descend(q, top, lo, mid);
+            if (!(top.bound() < plane_distance(diff)))
+                descend(q, top, mid + 1, hi);
+        } else {
+            descend(q, top, mid + 1, hi);
+            if (!(top.bound() < plane_distance(diff)))
+                descend(q, top, lo, mid);
+        }
+    }
+
+    D plane_distance(D diff) const noexcept {
+        return metric_ == Metric::l1 ? std::abs(diff) : diff * diff;
+    }
+
+    std::vector<Neighbor<D>> finish(detail::TopK<D>& top) const {
+        std::vector<Neighbor<D>> result = top.take_sorted();
+        for (Neighbor<D>& r : result)
+            r.distance = metric_ == Metric::cosine ? r.distance / D(2) : detail::finish_distance(metric_, r.distance);
+        return result;
+    }
+
+    Metric metric_;
+    std::size_t leaf_size_;
+    std::vector<Vector<D, N>> points_;
+    std::vector<std::size_t> ids_;
+    std::vector<std::uint8_t> split_;
+};
+
+// Паралельні запити: result[i] - k найближчих до queries[i] від найближчого. Запити
+// діляться між потоками частинами по Index::query_block, якщо config.chunk_size не задано.
+template<typename Index, typename U, std::size_t N>
+auto batch_nearest(const ExecutionConfig& config, const Index& index, const VectorBatch<U, N>& queries,
+                   std::size_t k) {
+    static_assert(Index::dimension == N, "query dimension must match the index");
+    using D = typename Index::distance_type;
+    VECTOR_TRACE_SPAN("batch_nearest");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, N * queries.size());
+    std::vector<std::vector<Neighbor<D>>> result(queries.size());
+    ExecutionConfig fixed = config;
+    if (fixed.chunk_size == 0)
+        fixed.chunk_size = Index::query_block;
+    parallel_for(fixed, queries.size(), N * sizeof(U), [&](std::size_t begin, std::size_t end) {
+        index.search_range(queries, begin, end, k, result.data());
+    });
+    return result;
+}
@@ -0,0 +1,266 @@
+// Matrix: матриці фіксованого розміру і пакетні перетворення
+#pragma once
+
+#include "vector_batch.hpp"
+
+// ---- Matrix: рядки - Vector, блочне множення з регістровими плитками ----
+
+// Рядкова матриця R x C; operator[] повертає рядок-Vector, тож m[r][c] працює як звичайно,
+// а кожен рядок зберігається з вирівнюванням Vector<T, C>
+template<typename T, std::size_t R, std::size_t C>
+class Matrix {
+public:
+    using value_type = T;
+    using row_type = Vector<T, C>;
+    static constexpr std::size_t rows = R;
+    static constexpr std::size_t cols = C;
+
+    constexpr Matrix() : rows_{} {}
+    constexpr explicit Matrix(const T& value) : rows_{} {
+        for (std::size_t r = 0; r < R; ++r)
+            rows_[r] = row_type(value);
+    }
+
+    // Matrix(v0, v1, ...) - по вектору на рядок; елементи приводяться до T
+    template<typename... V, std::enable_if_t<sizeof...(V) == R && (is_vector_v<V> && ...), int> = 0>
+    constexpr explicit Matrix(const V&... row_values) : rows_{{row_type(row_values)...}} {}
+
+    static constexpr Matrix identity() {
+        static_assert(R == C, "identity matrix must be square");
+        Matrix m;
+        for (std::size_t i = 0; i < R; ++i)
+            m.rows_[i].at_unchecked(i) = T(1);
+        return m;
+    }
+
+    constexpr row_type& operator[](int r) { return rows_[detail::access_index(r, R)]; }
+    constexpr const row_type& operator[](int r) const { return rows_[detail::access_index(r, R)]; }
+
+    constexpr T& at(int r, int c) { return rows_[detail::normalize_index(r, R)].at(c); }
+    constexpr const T& at(int r, int c) const { return rows_[detail::normalize_index(r, R)].at(c); }
+
+    constexpr row_type& row(std::size_t r) noexcept { return rows_[r]; }
+    constexpr const row_type& row(std::size_t r) const noexcept { return rows_[r]; }
+
+    constexpr Vector<T, R> column(std::size_t c) const noexcept {
+        Vector<T, R> result;
+        for (std::size_t r = 0; r < R; ++r)
+            result.at_unchecked(r) = rows_[r].at_unchecked(c);
+        return result;
+    }
+
+    constexpr auto begin() noexcept { return rows_.begin(); }
+    constexpr auto end() noexcept { return rows_.end(); }
+    constexpr auto begin() const noexcept { return rows_.begin(); }
+    constexpr auto end() const noexcept { return rows_.end(); }
+
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const Matrix& m) {
+        os << "[";
+        for (std::size_t r = 0; r < R; ++r)
+            os << m.rows_[r] << (r + 1 < R ? ", " : "");
+        os << "]";
+        return os;
+    }
+
+private:
+    std::array<row_type, R> rows_;
+};
+
+template<typename T, std::size_t R, std::size_t C>
+constexpr Matrix<T, C, R> transpose(const Matrix<T, R, C>& m) {
+    // Плитки 8 x 8: і читання рядків, і запис стовпців лишаються в кількох кеш-лініях
+    constexpr std::size_t tile = 8;
+    Matrix<T, C, R> t;
+    for (std::size_t ib = 0; ib < R; ib += tile) {
+        for (std::size_t jb = 0; jb < C; jb += tile) {
+            for (std::size_t i = ib; i < std::min(ib + tile, R); ++i)
+                for (std::size_t j = jb; j < std::min(jb + tile, C); ++j)
+                    t.row(j).at_unchecked(i) = m.row(i).at_unchecked(j);
+        }
+    }
+    return t;
+}
+
+// Рядок результату - скалярний добуток рядка матриці з v (SIMD для довгих рядків)
+template<typename T, std::size_t R, std::size_t C, typename V, std::enable_if_t<is_vector_operand_v<V>, int> = 0>
+constexpr auto matvec(const Matrix<T, R, C>& m, const V& v) {
+    static_assert(std::decay_t<V>::dimension == C, "matrix columns must match vector dimension");
+    using P = Promote<T, typename std::decay_t<V>::value_type>;
+    Vector<P, R> result;
+    const auto row_dot = [&m, &v, &result](std::size_t r) { result.at_unchecked(r) = dot(m.row(r), v); };
+    detail::static_for<0, R>(row_dot);
+    return result;
+}
+
+namespace detail {
+
+// Блоки: панель b розміру matmul_block_k x matmul_block_n лишається в L2,
+// мікроядро тримає 4 рядки x 2 пакети результату в регістрах протягом усього проходу по k
+constexpr std::size_t matmul_block_k = 128;
+constexpr std::size_t matmul_block_n = 256;
+constexpr std::size_t matmul_tile_rows = 4;
+
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+void matmul_tile(const Matrix<T, R, K>& a, const Matrix<T, K, C>& b, Matrix<T, R, C>& out,
+                 std::size_t i, std::size_t j, std::size_t k0, std::size_t k1) {
+    using P = simd::Packet<T>;
+    constexpr std::size_t W = P::width, MR = matmul_tile_rows;
+    typename P::type acc[MR][2];
+    for (std::size_t r = 0; r < MR; ++r) {
+        acc[r][0] = P::load(out.row(i + r).data() + j);
+        acc[r][1] = P::load(out.row(i + r).data() + j + W);
+    }
+    for (std::size_t k = k0; k < k1; ++k) {
+        const T* bk = b.row(k).data() + j;
+        const auto b0 = P::load(bk), b1 = P::load(bk + W);
+        for (std::size_t r = 0; r < MR; ++r) {
+            const auto ar = P::broadcast(a.row(i + r).at_unchecked(k));
+            acc[r][0] = P::fma(ar, b0, acc[r][0]);
+            acc[r][1] = P::fma(ar, b1, acc[r][1]);
+        }
+    }
+    for (std::size_t r = 0; r < MR; ++r) {
+        P::store(out.row(i + r).data() + j, acc[r][0]);
+        P::store(out.row(i + r).data() + j + W, acc[r][1]);
+    }
+}
+
+// out += a * b; out на вході нульова
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+void matmul_blocked(const Matrix<T, R, K>& a, const Matrix<T, K, C>& b, Matrix<T, R, C>& out) {
+    using P = simd::Packet<T>;
+    constexpr std::size_t W = P::width, MR = matmul_tile_rows;
+    for (std::size_t jc = 0; jc < C; jc += matmul_block_n) {
+        const std::size_t jend = std::min(C, jc + matmul_block_n);
+        for (std::size_t kc = 0; kc < K; kc += matmul_block_k) {
+            const std::size_t kend = std::min(K, kc + matmul_block_k);
+            for (std::size_t i = 0; i < R; i += MR) {
+                const std::size_t iend = std::min(R, i + MR);
+                std::size_t j = jc;
+                if (iend - i == MR) {
+                    for (; j + 2 * W <= jend; j += 2 * W)
+                        matmul_tile(a, b, out, i, j, kc, kend);
+                }
+                // Неповна плитка: по пакету, потім скалярний хвіст
+                for (std::size_t r = i; r < iend; ++r) {
+                    T* o = out.row(r).data();
+                    std::size_t jj = j;
+                    for (; jj + W <= jend; jj += W) {
+                        auto acc = P::load(o + jj);
+                        for (std::size_t k = kc; k < kend; ++k)
+                            acc = P::fma(P::broadcast(a.row(r).at_unchecked(k)), P::load(b.row(k).data() + jj), acc);
+                        P::store(o + jj, acc);
+                    }
+                    for (; jj < jend; ++jj) {
+                        T s = o[jj];
+                        for (std::size_t k = kc; k < kend; ++k)
+                            s = simd::mul_add(a.row(r).at_unchecked(k), b.row(k).at_unchecked(jj), s);
+                        o[jj] = s;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+template<typename T, std::size_t R, std::size_t K, typename U, std::size_t C>
+constexpr auto matmul(const Matrix<T, R, K>& a, const Matrix<U, K, C>& b) {
+    using P = Promote<T, U>;
+    Matrix<P, R, C> out;
+    if constexpr (std::is_same_v<T, P> && std::is_same_v<U, P> && simd::Packet<P>::enabled &&
+                  simd::Packet<P>::has_mul && C >= simd::Packet<P>::width) {
+        if (!VECTOR_IS_CONSTANT_EVALUATED()) {
+            detail::matmul_blocked(a, b, out);
+            return out;
+        }
+    }
+    // Порядок i-k-j: рядок результату накопичується як комбінація рядків b
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t k = 0; k < K; ++k) {
+            const P aik = static_cast<P>(a.row(i).at_unchecked(k));
+            for (std::size_t j = 0; j < C; ++j)
+                out.row(i).at_unchecked(j) += aik * static_cast<P>(b.row(k).at_unchecked(j));
+        }
+    }
+    return out;
+}
+
+template<typename T, std::size_t R, std::size_t K, typename U, std::size_t C>
+constexpr auto operator*(const Matrix<T, R, K>& a, const Matrix<U, K, C>& b) { return matmul(a, b); }
+
+template<typename T, std::size_t R, std::size_t C, typename V, std::enable_if_t<is_vector_operand_v<V>, int> = 0>
+constexpr auto operator*(const Matrix<T, R, C>& m, const V& v) { return matvec(m, v); }
+
+namespace detail {
+
+// out[r][i] = bias[r] + sum_c m[r][c] * in[c][i] для i з [begin, end): на кожен пакет точок
+// всі C вхідних пакетів читаються один раз, а коефіцієнти розгорнуті в регістри заздалегідь.
+// Affine: m має розмір (C + 1) x (C + 1), останній стовпець - зсув, останній рядок не використовується
+template<bool Affine, typename T, std::size_t MR, std::size_t MC, typename U, std::size_t C, typename V, std::size_t R>
+void transform_range(const Matrix<T, MR, MC>& m, const VectorBatch<U, C>& in, VectorBatch<V, R>& out,
+                     std::size_t begin, std::size_t end) {
+    V coef[R][C], bias[R];
+    const U* src[C];
+    V* dst[R];
+    for (std::size_t c = 0; c < C; ++c)
+        src[c] = in.column(c);
+    for (std::size_t r = 0; r < R; ++r) {
+        dst[r] = out.column(r);
+        bias[r] = Affine ? static_cast<V>(m.row(r).at_unchecked(C)) : V{};
+        for (std::size_t c = 0; c < C; ++c)
+            coef[r][c] = static_cast<V>(m.row(r).at_unchecked(c));
+    }
+    std::size_t i = begin;
+    if constexpr (std::is_same_v<U, V> && simd::Packet<V>::enabled && simd::Packet<V>::has_mul) {
+        using P = simd::Packet<V>;
+        typename P::type pc[R][C], pb[R];
+        for (std::size_t r = 0; r < R; ++r) {
+            pb[r] = P::broadcast(bias[r]);
+            for (std::size_t c = 0; c < C; ++c)
+                pc[r][c] = P::broadcast(coef[r][c]);
+        }
+        for (const std::size_t full = end - (end - begin) % P::width; i < full; i += P::width) {
+            typename P::type x[C];
+            for (std::size_t c = 0; c < C; ++c)
+                x[c] = P::load(src[c] + i);
+            for (std::size_t r = 0; r < R; ++r) {
+                auto acc = pb[r];
+                for (std::size_t c = 0; c < C; ++c)
+                    acc = P::fma(pc[r][c], x[c], acc);
+                P::store(dst[r] + i, acc);
+            }
+        }
+    }
+    for (; i < end; ++i) {
+        for (std::size_t r = 0; r < R; ++r) {
+            V s = bias[r];
+            for (std::size_t c = 0; c < C; ++c)
+                s = simd::mul_add(coef[r][c], static_cast<V>(src[c][i]), s);
+            dst[r][i] = s;
+        }
+    }
+}
+
+} // namespace detail
+
+// result[i] = m * points[i] для кожної точки пакета (3x3, 4x4 і будь-які R x C)
+template<typename T, std::size_t R, std::size_t C, typename U>
+auto transform(const Matrix<T, R, C>& m, const VectorBatch<U, C>& points) {
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, C * points.size());
+    VectorBatch<Promote<T, U>, R> result(points.size());
+    detail::transform_range<false>(m, points, result, 0, points.size());
+    return result;
+}
+
+// Афінне перетворення однорідною матрицею (N + 1) x (N + 1): точки мають w = 1,
+// останній рядок матриці (проєктивна частина) не використовується
+template<typename T, std::size_t M, typename U>
+auto transform_points(const Matrix<T, M, M>& m, const VectorBatch<U, M - 1>& points) {
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, (M - 1) * points.size());
+    VectorBatch<Promote<T, U>, M - 1> result(points.size());
+    detail::transform_range<true>(m, points, result, 0, points.size());
+    return result;
+}
@@ -0,0 +1,589 @@
+// Паралельне виконання пакетних операцій: пул потоків, черга, parallel_for
+#pragma once
+
+#include "vector_matrix.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <thread>
+
+// ---- Паралельне виконання пакетних операцій ----
+
+// Бекенд std::execution вмикається явно (-DVECTOR_USE_STD_EXECUTION): у libstdc++
+// він вимагає компонування з TBB. Без нього ExecutionBackend::std_parallel
+// виконується пулом потоків.
+#if defined(VECTOR_USE_STD_EXECUTION)
+#  include <execution>
+#  if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201603L
+#    define VECTOR_HAS_STD_EXECUTION 1
+#  endif
+#endif
+
+// Пул потоків з крадіжкою роботи: кожен робітник має власну чергу,
+// бере завдання з її кінця, а за порожньої черги краде з початку чужих.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency())
+        : queues_(threads == 0 ? 1 : threads) {
+        for (auto& q : queues_)
+            q = std::make_unique<Queue>();
+        workers_.reserve(queues_.size());
+        for (std::size_t i = 0; i < queues_.size(); ++i)
+            workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_)
+            w.join();
+    }
+
+    std::size_t size() const noexcept { return workers_.size(); }
+
+    void submit(std::function<void()> task) {
+        // Завдання від робітника лишається в його черзі, зовнішні розподіляються по колу
+        std::size_t target = (current_pool() == this)
+            ? current_index()
+            : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            ++pending_;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+            queues_[target]->tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> next_queue_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::size_t pending_ = 0;
+    bool stop_ = false;
+
+    static ThreadPool*& current_pool() {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static std::size_t& current_index() {
+        thread_local std::size_t index = 0;
+        return index;
+    }
+
+    bool try_pop(std::size_t self, std::function<void()>& task) {
+        {
+            Queue& own = *queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < queues_.size(); ++k) {
+            Queue& victim = *queues_[(self + k) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(std::size_t index) {
+        current_pool() = this;
+        current_index() = index;
+        std::function<void()> task;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+                if (pending_ == 0 && stop_)
+                    return;
+            }
+            if (try_pop(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex_);
+                    --pending_;
+                }
+                task();
+                task = nullptr;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+// Обмежена черга між стадіями конвеєра: push чекає, коли черга повна,
+// pop - коли порожня. Після close() push відмовляє, а pop видає залишок і повертає false.
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_)
+            return false;
+        items_.push_back(std::move(value));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty())
+            return false;
+        out = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<T> items_;
+    std::size_t capacity_;
+    bool closed_ = false;
+};
+
+enum class ExecutionBackend {
+    sequential,
+    thread_pool,
+    std_parallel   // std::execution::par_unseq, якщо стандартна бібліотека його надає
+};
+
+// chunk_size = 0 - розмір частини підбирається під кеш (chunk_bytes на частину),
+// threads = 0 - усі потоки пулу
+struct ExecutionConfig {
+    ExecutionBackend backend = ExecutionBackend::thread_pool;
+    std::size_t threads = 0;
+    std::size_t chunk_size = 0;
+    std::size_t chunk_bytes = 64 * 1024;
+    ThreadPool* pool = nullptr;
+
+    std::size_t resolve_chunk(std::size_t bytes_per_item) const noexcept {
+        if (chunk_size != 0)
+            return chunk_size;
+        std::size_t items = chunk_bytes / (bytes_per_item == 0 ? 1 : bytes_per_item);
+        return items == 0 ? 1 : items;
+    }
+};
+
+namespace detail {
+
+struct ParallelForState {
+    std::size_t count = 0;
+    std::size_t chunk = 1;
+    std::size_t chunks = 0;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+    std::function<void(std::size_t, std::size_t)> body;
+
+    // Бере частини, доки вони є; повертає, коли спільний лічильник вичерпано
+    void run() {
+        for (std::size_t c; (c = next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+            const std::size_t begin = c * chunk;
+            const std::size_t end = (begin + chunk < count) ? begin + chunk : count;
+#if VECTOR_HAS_EXCEPTIONS
+            try {
+                body(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+#else
+            body(begin, end);
+#endif
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+// Викликає body(begin, end) для частин діапазону [0, count) і чекає завершення.
+// Потік, що викликає, теж обробляє частини, тому вкладені виклики не блокуються.
+template<typename F>
+void parallel_for(const ExecutionConfig& config, std::size_t count, std::size_t bytes_per_item, F&& body) {
+    if (count == 0)
+        return;
+    const std::size_t chunk = config.resolve_chunk(bytes_per_item);
+    const std::size_t chunks = (count + chunk - 1) / chunk;
+
+    if (config.backend == ExecutionBackend::sequential || chunks == 1) {
+        for (std::size_t begin = 0; begin < count; begin += chunk) {
+            VECTOR_TRACE_SPAN("parallel_for.chunk");
+            body(begin, (begin + chunk < count) ? begin + chunk : count);
+        }
+        return;
+    }
+
+#if defined(VECTOR_HAS_STD_EXECUTION)
+    if (config.backend == ExecutionBackend::std_parallel) {
+        std::vector<std::size_t> ids(chunks);
+        for (std::size_t c = 0; c < chunks; ++c)
+            ids[c] = c;
+        std::for_each(std::execution::par_unseq, ids.begin(), ids.end(), [&](std::size_t c) {
+            const std::size_t begin = c * chunk;
+            VECTOR_TRACE_SPAN("parallel_for.chunk");
+            body(begin, (begin + chunk < count) ? begin + chunk : count);
+        });
+        return;
+    }
+#endif
+
+    ThreadPool& pool = config.pool ? *config.pool : ThreadPool::shared();
+    std::size_t workers = config.threads == 0 ? pool.size() + 1 : config.threads;
+    if (workers > chunks)
+        workers = chunks;
+
+    auto state = std::make_shared<detail::ParallelForState>();
+    state->count = count;
+    state->chunk = chunk;
+    state->chunks = chunks;
+    state->body = [&body](std::size_t b, std::size_t e) {
+        VECTOR_TRACE_SPAN("parallel_for.chunk");
+        body(b, e);
+    };
+    for (std::size_t w = 1; w < workers; ++w)
+        pool.submit([state] { state->run(); });
+    state->run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done.load(std::memory_order_acquire) == chunks; });
+#if VECTOR_HAS_EXCEPTIONS
+    if (state->error)
+        std::rethrow_exception(state->error);
+#endif
+}
+
+// out[i] = op(a[i], b[i]) для масивів векторів; op повертає вектор або вираз
+template<typename A, typename B, typename R, typename Op>
+void batch_apply(const ExecutionConfig& config, const A* a, const B* b, R* out, std::size_t count, Op op) {
+    VECTOR_TRACE_SPAN("batch_apply");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, count);
+    parallel_for(config, count, sizeof(A) + sizeof(B) + sizeof(R), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = op(a[i], b[i]);
+    });
+}
+
+template<typename T, typename U, std::size_t N, typename Op>
+auto batch_apply(const ExecutionConfig& config, const VectorBatch<T, N>& a, const VectorBatch<U, N>& b, Op op) {
+    using R = Promote<T, U>;
+    detail::check_batch_sizes(a.size(), b.size());
+    VECTOR_TRACE_SPAN("batch_apply");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, N * a.size());
+    VectorBatch<R, N> result(a.size());
+    parallel_for(config, a.size(), N * (sizeof(T) + sizeof(U) + sizeof(R)), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = 0; c < N; ++c)
+            detail::column_transform(a.column(c) + begin, b.column(c) + begin, result.column(c) + begin, end - begin, op);
+    });
+    return result;
+}
+
+template<typename T, std::size_t N, typename U, typename Op>
+auto batch_apply_scalar(const ExecutionConfig& config, const VectorBatch<T, N>& a, const U& scalar, Op op) {
+    using R = Promote<T, U>;
+    using S = detail::scalar_storage_t<T, U>;
+    VECTOR_TRACE_SPAN("batch_apply_scalar");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, N * a.size());
+    VectorBatch<R, N> result(a.size());
+    const S s = static_cast<S>(scalar);
+    parallel_for(config, a.size(), N * (sizeof(T) + sizeof(R)), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = 0; c < N; ++c)
+            detail::column_transform_scalar(a.column(c) + begin, s, result.column(c) + begin, end - begin, op);
+    });
+    return result;
+}
+
+template<typename T1, std::size_t N, std::size_t A1, typename U1, typename T2, std::size_t A2, typename U2>
+void batch_weighted_sum(const ExecutionConfig& config,
+                        const Vector<T1, N, A1>* v1, const U1& alpha,
+                        const Vector<T2, N, A2>* v2, const U2& beta,
+                        decltype(weighted_sum(*v1, alpha, *v2, beta))* out, std::size_t count) {
+    VECTOR_TRACE_SPAN("batch_weighted_sum");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, N * count);
+    parallel_for(config, count, sizeof(*v1) + sizeof(*v2) + sizeof(*out), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = weighted_sum(v1[i], alpha, v2[i], beta);
+    });
+}
+
+template<typename T1, std::size_t N, typename U1, typename T2, typename U2>
+auto batch_weighted_sum(const ExecutionConfig& config,
+                        const VectorBatch<T1, N>& b1, const U1& alpha,
+                        const VectorBatch<T2, N>& b2, const U2& beta) {
+    using R = typename decltype(weighted_sum(b1, alpha, b2, beta))::value_type;
+    detail::check_batch_sizes(b1.size(), b2.size());
+    VECTOR_TRACE_SPAN("batch_weighted_sum");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, N * b1.size());
+    VectorBatch<R, N> result(b1.size());
+    parallel_for(config, b1.size(), N * (sizeof(T1) + sizeof(T2) + sizeof(R)), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = 0; c < N; ++c) {
+            const T1* x = b1.column(c);
+            const T2* y = b2.column(c);
+            R* out = result.column(c);
+            if constexpr (std::is_same_v<T1, R> && std::is_same_v<T2, R> &&
+                          std::is_arithmetic_v<U1> && std::is_arithmetic_v<U2>) {
+                dispatch::axpby(static_cast<R>(alpha), x + begin, static_cast<R>(beta), y + begin, out + begin, end - begin);
+            } else {
+                for (std::size_t i = begin; i < end; ++i)
+                    out[i] = alpha * x[i] + beta * y[i];
+            }
+        }
+    });
+    return result;
+}
+
+// Згортка: map(begin, end) дає частковий результат частини, частинні результати
+// поєднуються combine у порядку частин, тож результат не залежить від кількості потоків
+template<typename Acc, typename Map, typename Combine>
+Acc batch_reduce(const ExecutionConfig& config, std::size_t count, std::size_t bytes_per_item,
+                 Acc identity, Map map, Combine combine) {
+    VECTOR_TRACE_SPAN("batch_reduce");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, count);
+    const std::size_t chunk = config.resolve_chunk(bytes_per_item);
+    const std::size_t chunks = (count + chunk - 1) / chunk;
+    std::vector<Acc> partials(chunks, identity);
+    ExecutionConfig fixed = config;
+    fixed.chunk_size = chunk;
+    parallel_for(fixed, count, bytes_per_item, [&](std::size_t begin, std::size_t end) {
+        partials[begin / chunk] = map(begin, end);
+    });
+    Acc result = identity;
+    for (const Acc& p : partials)
+        result = combine(result, p);
+    return result;
+}
+
+template<typename T, std::size_t N, std::size_t A>
+auto batch_sum(const ExecutionConfig& config, const Vector<T, N, A>* data, std::size_t count) {
+    using R = Promote<T, T>;
+    return batch_reduce(config, count, sizeof(Vector<T, N, A>), Vector<R, N>{},
+        [data](std::size_t begin, std::size_t end) {
+            Vector<R, N> acc;
+            for (std::size_t i = begin; i < end; ++i)
+                acc = acc + data[i];
+            return acc;
+        },
+        [](const Vector<R, N>& x, const Vector<R, N>& y) { return Vector<R, N>(x + y); });
+}
+
+template<typename T, std::size_t N>
+auto batch_sum(const ExecutionConfig& config, const VectorBatch<T, N>& batch) {
+    using R = Promote<T, T>;
+    return batch_reduce(config, batch.size(), N * sizeof(T), Vector<R, N>{},
+        [&batch](std::size_t begin, std::size_t end) {
+            Vector<R, N> acc;
+            for (std::size_t c = 0; c < N; ++c) {
+                const T* col = batch.column(c);
+                R s{};
+                if constexpr (VECTOR_RUNTIME_DISPATCH && dispatch::dispatchable_v<T> && std::is_same_v<T, R>) {
+                    s = dispatch::kernels<T>().sum(col + begin, end - begin);
+                } else if constexpr (simd::Packet<T>::enabled && std::is_same_v<T, R>) {
+                    s = simd::sum(col + begin, end - begin);
+                } else {
+                    for (std::size_t i = begin; i < end; ++i)
+                        s += col[i];
+                }
+                acc.at_unchecked(c) = s;
+            }
+            return acc;
+        },
+        [](const Vector<R, N>& x, const Vector<R, N>& y) { return Vector<R, N>(x + y); });
+}
+
+template<typename T, std::size_t R, std::size_t C, typename U>
+auto batch_transform(const ExecutionConfig& config, const Matrix<T, R, C>& m, const VectorBatch<U, C>& points) {
+    using V = Promote<T, U>;
+    VECTOR_TRACE_SPAN("batch_transform");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, C * points.size());
+    VectorBatch<V, R> result(points.size());
+    parallel_for(config, points.size(), C * sizeof(U) + R * sizeof(V), [&](std::size_t begin, std::size_t end) {
+        detail::transform_range<false>(m, points, result, begin, end);
+    });
+    return result;
+}
+
+template<typename T, std::size_t M, typename U>
+auto batch_transform_points(const ExecutionConfig& config, const Matrix<T, M, M>& m,
+                            const VectorBatch<U, M - 1>& points) {
+    using V = Promote<T, U>;
+    VECTOR_TRACE_SPAN("batch_transform_points");
+    VECTOR_COUNT_CALL(instrumentation::Op::batch, (M - 1) * points.size());
+    VectorBatch<V, M - 1> result(points.size());
+    parallel_for(config, points.size(), (M - 1) * (sizeof(U) + sizeof(V)), [&](std::size_t begin, std::size_t end) {
+        detail::transform_range<true>(m, points, result, begin, end);
+    });
+    return result;
+}
+
+// ---- ConcurrentAccumulator: суми векторів з багатьох потоків без м'ютекса ----
+
+namespace detail {
+
+// Порядковий номер потоку, що вперше звернувся до накопичувача
+inline std::size_t thread_ordinal() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t ordinal = next.fetch_add(1, std::memory_order_relaxed);
+    return ordinal;
+}
+
+[[noreturn]] VECTOR_COLD inline void fail_slot_out_of_range(std::size_t slot, std::size_t slots) {
+    char message[96];
+    std::snprintf(message, sizeof message, "ConcurrentAccumulator slot %zu out of range for %zu slots", slot, slots);
+    raise_error<std::out_of_range>(message);
+}
+
+// Для цілих - fetch_add; для дійсних - CAS, що без конкуренції за слот проходить з першої спроби
+template<typename T>
+void atomic_accumulate(std::atomic<T>& target, T value) noexcept {
+    if constexpr (std::is_integral_v<T>) {
+        target.fetch_add(value, std::memory_order_relaxed);
+    } else {
+        T current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, current + value,
+                                             std::memory_order_relaxed, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+} // namespace detail
+
+// Кожен потік додає у власний слот на окремій кеш-лінії, total() зводить слоти в порядку
+// їхніх номерів. Потоків може бути більше, ніж слотів: спільний слот лишається коректним,
+// лише повільнішим. Тип T має вміщувати Promote<T, U> доданків.
+//
+// Для відтворюваних дійсних сум додавайте через add(slot, v) з детермінованим номером
+// (наприклад, номером частини parallel_for при фіксованому chunk_size) і слотів не менше,
+// ніж частин: тоді в кожен слот пише один потік у фіксованому порядку, і total() не залежить
+// від кількості потоків. Тому add(slot, v) не згортає номер, а перевіряє slot < slots().
+// total() під час паралельних add() дає узгоджені компоненти, але не знімок усього вектора.
+template<typename T, std::size_t N>
+class ConcurrentAccumulator {
+    static_assert(std::is_arithmetic_v<T>, "ConcurrentAccumulator needs an arithmetic type");
+    static_assert(std::atomic<T>::is_always_lock_free, "ConcurrentAccumulator needs lock-free atomics for T");
+
+public:
+    using value_type = T;
+    static constexpr std::size_t dimension = N;
+
+    // slots = 0 - удвічі більше за апаратні потоки
+    explicit ConcurrentAccumulator(std::size_t slots = 0)
+        : count_(slots != 0 ? slots : 2 * std::max<std::size_t>(1, std::thread::hardware_concurrency())),
+          slots_(new Slot[count_]) {
+        reset();
+    }
+
+    ConcurrentAccumulator(const ConcurrentAccumulator&) = delete;
+    ConcurrentAccumulator& operator=(const ConcurrentAccumulator&) = delete;
+
+    std::size_t slots() const noexcept { return count_; }
+
+    // Додає у слот поточного потоку
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    void add(const E& v) noexcept {
+        accumulate(detail::thread_ordinal() % count_, v);
+    }
+
+    // Додає у слот з номером slot; slot < slots()
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    void add(std::size_t slot, const E& v) {
+        VECTOR_EXPECTS(slot < count_, detail::fail_slot_out_of_range(slot, count_));
+        accumulate(slot, v);
+    }
+
+    // Сума всіх слотів; порядок зведення фіксований, mode - як у sum()
+    Vector<T, N> total(Summation mode = Summation::fast) const noexcept {
+        Vector<T, N> result;
+        for (std::size_t c = 0; c < N; ++c) {
+            auto term = [this, c](std::size_t s) { return slots_[s].values[c].load(std::memory_order_relaxed); };
+            T s{};
+            if (std::is_floating_point_v<T> && mode == Summation::kahan)
+                s = detail::kahan_sum<T>(term, count_);
+            else if (std::is_floating_point_v<T> && mode == Summation::pairwise)
+                s = detail::pairwise_sum<T>(term, 0, count_);
+            else
+                s = detail::multi_accumulator_sum<T>(term, count_);
+            result.at_unchecked(c) = s;
+        }
+        return result;
+    }
+
+    void reset() noexcept {
+        for (std::size_t s = 0; s < count_; ++s)
+            for (std::size_t c = 0; c < N; ++c)
+                slots_[s].values[c].store(T{}, std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<T> values[N];
+    };
+
+    std::size_t count_;
+    std::unique_ptr<Slot[]> slots_;
+
+    template<typename E>
+    void accumulate(std::size_t slot, const E& v) noexcept {
+        using U = typename std::decay_t<E>::value_type;
+        static_assert(std::is_same_v<Promote<T, U>, T>,
+                      "accumulator type must hold Promote<T, U>; widen T");
+        std::atomic<T>* target = slots_[slot].values;
+        for (std::size_t c = 0; c < N; ++c)
+            detail::atomic_accumulate(target[c], static_cast<T>(detail::element(v, c)));
+    }
+};
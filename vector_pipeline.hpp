@@ -0,0 +1,251 @@
+// Потокові конвеєри на корутинах C++20: розбір -> перетворення -> запис частинами VectorBatch
+#pragma once
+
+#include "vector_io.hpp"
+#include "vector_parallel.hpp"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#  if __has_include(<coroutine>)
+#    include <coroutine>
+#    include <iterator>
+#    include <ostream>
+#    define VECTOR_HAS_COROUTINES 1
+#  endif
+#endif
+
+#if defined(VECTOR_HAS_COROUTINES)
+
+// ---- Generator: лінивий синхронний потік значень для co_yield ----
+
+// Значення живе в кадрі корутини до наступного кроку, тож споживач може забрати його std::move.
+// Виняток з тіла корутини перекидається з begin() або operator++.
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        T* current = nullptr;
+#if VECTOR_HAS_EXCEPTIONS
+        std::exception_ptr error;
+#endif
+
+        Generator get_return_object() noexcept {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        std::suspend_always yield_value(T&& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+#if VECTOR_HAS_EXCEPTIONS
+            error = std::current_exception();
+#else
+            std::terminate();
+#endif
+        }
+
+        // Генератор синхронний: co_await у його тілі не має сенсу
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        explicit iterator(handle_type handle) noexcept : handle_(handle) {}
+
+        T& operator*() const noexcept { return *handle_.promise().current; }
+        T* operator->() const noexcept { return handle_.promise().current; }
+
+        iterator& operator++() {
+            handle_.resume();
+            rethrow_if_failed(handle_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const noexcept { return !handle_ || handle_.done(); }
+
+    private:
+        handle_type handle_;
+    };
+
+    Generator() = default;
+    Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    ~Generator() {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    // Обхід лише один раз: begin() запускає корутину до першого co_yield
+    iterator begin() {
+        if (handle_) {
+            handle_.resume();
+            rethrow_if_failed(handle_);
+        }
+        return iterator(handle_);
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit Generator(handle_type handle) noexcept : handle_(handle) {}
+
+    static void rethrow_if_failed(handle_type handle) {
+#if VECTOR_HAS_EXCEPTIONS
+        if (handle.done() && handle.promise().error)
+            std::rethrow_exception(handle.promise().error);
+#else
+        (void)handle;
+#endif
+    }
+
+    handle_type handle_;
+};
+
+// ---- Стадії конвеєра над частинами VectorBatch<T, N> ----
+
+// Джерело: читає потік блоками по chunk_bytes тим самим розбором, що й parse_vector_lines,
+// і видає пакети до chunk_size векторів. Хибні рядки рахуються в *stats, якщо його передано.
+// Потік і stats мають жити, доки генератор не вичерпано або не знищено.
+template<typename T, std::size_t N>
+Generator<VectorBatch<T, N>> read_vector_chunks(std::istream& in, std::size_t chunk_size = 4096,
+                                                LineParseStats* stats = nullptr,
+                                                std::size_t chunk_bytes = 1 << 16) {
+    LineParseStats local;
+    LineParseStats& st = stats ? *stats : local;
+    if (chunk_size == 0)
+        chunk_size = 1;
+    VectorBatch<T, N> chunk;
+    chunk.reserve(chunk_size);
+    auto sink = [&chunk](const Vector<T, N>& v) { chunk.push_back(v); };
+
+    std::string buffer;
+    std::size_t carried = 0;
+    while (in) {
+        buffer.resize(carried + chunk_bytes);
+        in.read(buffer.data() + carried, static_cast<std::streamsize>(chunk_bytes));
+        const std::size_t filled = carried + static_cast<std::size_t>(in.gcount());
+        const std::string_view text(buffer.data(), filled);
+        const std::size_t last_eol = text.rfind('\n');
+        if (last_eol == std::string_view::npos) {
+            carried = filled;
+            continue;
+        }
+        for (std::size_t pos = 0; pos <= last_eol;) {
+            const std::size_t eol = text.find('\n', pos);
+            detail::parse_vector_line<T, N>(text.substr(pos, eol - pos), st, sink);
+            pos = eol + 1;
+            if (chunk.size() >= chunk_size) {
+                co_yield std::move(chunk);
+                chunk = VectorBatch<T, N>();
+                chunk.reserve(chunk_size);
+            }
+        }
+        carried = filled - last_eol - 1;
+        std::memmove(buffer.data(), buffer.data() + last_eol + 1, carried);
+    }
+    if (carried > 0)
+        detail::parse_vector_line<T, N>(std::string_view(buffer.data(), carried), st, sink);
+    if (!chunk.empty())
+        co_yield std::move(chunk);
+}
+
+// Перетворення: f(chunk) для кожної частини, зазвичай пакетні операції VectorBatch
+// (b * s, b1 + b2, weighted_sum, b.convert<U>()), які працюють стовпцями через SIMD
+template<typename T, typename F>
+auto transform_chunks(Generator<T> source, F f)
+    -> Generator<std::decay_t<std::invoke_result_t<F&, T&>>> {
+    for (T& chunk : source)
+        co_yield f(chunk);
+}
+
+// Виносить стадію source в окремий потік. Частини переходять через BoundedQueue на capacity
+// елементів: повна черга зупиняє виробника (зворотний тиск), а знищення генератора раніше
+// кінця закриває чергу, і виробник завершується на наступному push. Виняток виробника
+// перекидається споживачу після вже переданих частин.
+template<typename T>
+Generator<T> run_on_thread(Generator<T> source, std::size_t capacity = 4) {
+    struct Channel {
+        explicit Channel(std::size_t c) : queue(c) {}
+        BoundedQueue<T> queue;
+#if VECTOR_HAS_EXCEPTIONS
+        std::exception_ptr error;
+#endif
+    };
+    auto channel = std::make_shared<Channel>(capacity);
+    std::thread producer([channel, src = std::move(source)]() mutable {
+#if VECTOR_HAS_EXCEPTIONS
+        try {
+#endif
+            for (T& item : src)
+                if (!channel->queue.push(std::move(item)))
+                    break;
+#if VECTOR_HAS_EXCEPTIONS
+        } catch (...) {
+            channel->error = std::current_exception();
+        }
+#endif
+        channel->queue.close();
+    });
+    struct Join {
+        std::thread& thread;
+        Channel& channel;
+        ~Join() {
+            channel.queue.close();
+            thread.join();
+        }
+    } join{producer, *channel};
+
+    T item;
+    while (channel->queue.pop(item))
+        co_yield std::move(item);
+#if VECTOR_HAS_EXCEPTIONS
+    if (channel->error)
+        std::rethrow_exception(channel->error);
+#endif
+}
+
+// Приймач: пише кожен вектор рядком "[a, b, c]" через format_vector, по одному
+// out.write на частину. Повертає кількість записаних векторів.
+template<typename T, std::size_t N>
+std::size_t write_vector_chunks(Generator<VectorBatch<T, N>> source, std::ostream& out) {
+    std::size_t written = 0;
+    std::string text;
+    for (const VectorBatch<T, N>& chunk : source) {
+        text.clear();
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            format_vector(text, chunk[i]);
+            text.push_back('\n');
+        }
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        written += chunk.size();
+    }
+    return written;
+}
+
+#endif // VECTOR_HAS_COROUTINES
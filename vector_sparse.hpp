@@ -0,0 +1,431 @@
+// SparseVector: розріджений вектор фіксованої розмірності з відсортованими індексами
+#pragma once
+
+#include "vector.hpp"
+#include <ostream>
+
+// ---- SparseVector: лише ненульові елементи, відсортовані за індексом ----
+
+template<typename T, std::size_t N>
+class SparseVector;
+
+template<typename T, std::size_t N>
+struct is_sparse_vector<SparseVector<T, N>> : std::true_type {};
+
+namespace detail {
+template<typename T, typename U, std::size_t N, typename F>
+void merge_sparse(const SparseVector<T, N>& a, const SparseVector<U, N>& b, F f);
+} // namespace detail
+
+// Пам'ять - nnz() пар (індекс, значення) замість N елементів, операції проходять лише
+// збережені елементи. Розмірність і правила Promote ті самі, що у Vector<T, N>.
+// Результати арифметики можуть містити явні нулі (напр. a - a); prune() їх прибирає.
+template<typename T, std::size_t N>
+class SparseVector {
+    static_assert(N > 0, "SparseVector dimension must be positive");
+
+public:
+    using value_type = T;
+    using index_type = std::conditional_t<(N <= 0xFFFFFFFFull), std::uint32_t, std::size_t>;
+    static constexpr std::size_t dimension = N;
+
+    SparseVector() = default;
+
+    // Із щільного вектора чи виразу; нульові елементи не зберігаються
+    template<typename E, std::enable_if_t<is_vector_operand_v<E> && std::decay_t<E>::dimension == N, int> = 0>
+    explicit SparseVector(const E& dense) {
+        for (std::size_t i = 0; i < N; ++i) {
+            const auto x = detail::element(dense, i);
+            if (x != decltype(x){})
+                push_back(i, static_cast<T>(x));
+        }
+    }
+
+    // Пари (індекс, значення) у будь-якому порядку; повторний індекс замінює значення
+    SparseVector(std::initializer_list<std::pair<std::size_t, T>> items) {
+        for (const auto& [i, v] : items)
+            set(i, v);
+    }
+
+    template<typename U>
+    explicit SparseVector(const SparseVector<U, N>& other)
+        : indices_(other.indices().begin(), other.indices().end()) {
+        values_.reserve(other.nnz());
+        for (const U& v : other.values())
+            values_.push_back(static_cast<T>(v));
+    }
+
+    static constexpr std::size_t size() noexcept { return N; }
+    std::size_t nnz() const noexcept { return indices_.size(); }
+    bool empty() const noexcept { return indices_.empty(); }
+
+    const std::vector<index_type>& indices() const noexcept { return indices_; }
+    const std::vector<T>& values() const noexcept { return values_; }
+
+    void reserve(std::size_t count) {
+        indices_.reserve(count);
+        values_.reserve(count);
+    }
+
+    void clear() noexcept {
+        indices_.clear();
+        values_.clear();
+    }
+
+    // Швидке заповнення за зростанням індексів
+    void push_back(std::size_t index, const T& value) {
+        VECTOR_EXPECTS(index < N, detail::fail_out_of_range(static_cast<int>(index), N));
+        if (!indices_.empty() && indices_.back() >= index)
+            detail::raise_error<std::invalid_argument>("SparseVector::push_back: indices must increase");
+        indices_.push_back(static_cast<index_type>(index));
+        values_.push_back(value);
+    }
+
+    // Довільний запис за O(nnz) у гіршому разі; значення 0 теж зберігається
+    void set(std::size_t index, const T& value) {
+        VECTOR_EXPECTS(index < N, detail::fail_out_of_range(static_cast<int>(index), N));
+        const auto it = std::lower_bound(indices_.begin(), indices_.end(), index);
+        const std::size_t k = static_cast<std::size_t>(it - indices_.begin());
+        if (it != indices_.end() && *it == index) {
+            values_[k] = value;
+            return;
+        }
+        indices_.insert(it, static_cast<index_type>(index));
+        values_.insert(values_.begin() + static_cast<std::ptrdiff_t>(k), value);
+    }
+
+    // Читання за O(log nnz); відсутній елемент - нуль
+    T operator[](std::size_t index) const {
+        VECTOR_EXPECTS(index < N, detail::fail_out_of_range(static_cast<int>(index), N));
+        const auto it = std::lower_bound(indices_.begin(), indices_.end(), index);
+        return (it != indices_.end() && *it == index) ? values_[static_cast<std::size_t>(it - indices_.begin())] : T{};
+    }
+
+    // Прибирає елементи з |x| <= tolerance
+    SparseVector& prune(T tolerance = T{}) {
+        std::size_t out = 0;
+        for (std::size_t k = 0; k < nnz(); ++k) {
+            const T v = values_[k];
+            if (v > tolerance || v < -tolerance) {
+                indices_[out] = indices_[k];
+                values_[out] = v;
+                ++out;
+            }
+        }
+        indices_.resize(out);
+        values_.resize(out);
+        return *this;
+    }
+
+    Vector<T, N> to_dense() const {
+        Vector<T, N> result;
+        scatter(result.data());
+        return result;
+    }
+
+    // out[i] = значення для збережених i; решту out не чіпає
+    void scatter(T* out) const noexcept {
+        for (std::size_t k = 0; k < nnz(); ++k)
+            out[indices_[k]] = values_[k];
+    }
+
+    SparseVector operator-() const {
+        SparseVector result(*this);
+        for (T& v : result.values_)
+            v = static_cast<T>(-v);
+        return result;
+    }
+
+    template<typename U>
+    SparseVector& operator+=(const SparseVector<U, N>& rhs) { return *this = SparseVector(*this + rhs); }
+    template<typename U>
+    SparseVector& operator-=(const SparseVector<U, N>& rhs) { return *this = SparseVector(*this - rhs); }
+
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    SparseVector& operator*=(const U& scalar) {
+        for (T& v : values_)
+            v = static_cast<T>(v * scalar);
+        return *this;
+    }
+    template<typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+    SparseVector& operator/=(const U& scalar) {
+        for (T& v : values_)
+            v = static_cast<T>(v / scalar);
+        return *this;
+    }
+
+    // Рівність елементів, а не зберігання: явний нуль дорівнює відсутньому
+    template<typename U>
+    bool operator==(const SparseVector<U, N>& other) const {
+        bool equal = true;
+        detail::merge_sparse(*this, other, [&](std::size_t, const auto& a, const auto& b) { equal = equal && a == b; });
+        return equal;
+    }
+    template<typename U>
+    bool operator!=(const SparseVector<U, N>& other) const { return !(*this == other); }
+
+    // {i: x, j: y} за зростанням індексів
+    template<typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const SparseVector& v) {
+        os << '{';
+        for (std::size_t k = 0; k < v.nnz(); ++k) {
+            if (k > 0)
+                os << ", ";
+            os << v.indices_[k] << ": " << v.values_[k];
+        }
+        return os << '}';
+    }
+
+private:
+    template<typename U, std::size_t M>
+    friend class SparseVector;
+
+    std::vector<index_type> indices_;
+    std::vector<T> values_;
+};
+
+namespace detail {
+
+// Злиття за індексами: f(i, a_i, b_i) для кожного i, збереженого хоча б в одному,
+// відсутній елемент передається нулем відповідного типу
+template<typename T, typename U, std::size_t N, typename F>
+void merge_sparse(const SparseVector<T, N>& a, const SparseVector<U, N>& b, F f) {
+    const auto& ia = a.indices();
+    const auto& ib = b.indices();
+    const auto& va = a.values();
+    const auto& vb = b.values();
+    std::size_t i = 0, j = 0;
+    while (i < ia.size() && j < ib.size()) {
+        if (ia[i] < ib[j]) {
+            f(ia[i], va[i], U{});
+            ++i;
+        } else if (ib[j] < ia[i]) {
+            f(ib[j], T{}, vb[j]);
+            ++j;
+        } else {
+            f(ia[i], va[i], vb[j]);
+            ++i;
+            ++j;
+        }
+    }
+    for (; i < ia.size(); ++i)
+        f(ia[i], va[i], U{});
+    for (; j < ib.size(); ++j)
+        f(ib[j], T{}, vb[j]);
+}
+
+template<typename R, typename T, typename U, std::size_t N, typename Op>
+SparseVector<R, N> sparse_union(const SparseVector<T, N>& a, const SparseVector<U, N>& b, Op op) {
+    VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), a.nnz() + b.nnz());
+    SparseVector<R, N> result;
+    result.reserve(a.nnz() + b.nnz());
+    merge_sparse(a, b, [&](std::size_t i, const T& x, const U& y) {
+        result.push_back(i, static_cast<R>(op(static_cast<R>(x), static_cast<R>(y))));
+    });
+    return result;
+}
+
+template<typename R, typename T, std::size_t N, typename S, typename Op>
+SparseVector<R, N> sparse_scalar(const SparseVector<T, N>& a, const S& s, Op op) {
+    VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), a.nnz());
+    SparseVector<R, N> result;
+    result.reserve(a.nnz());
+    for (std::size_t k = 0; k < a.nnz(); ++k)
+        result.push_back(a.indices()[k], static_cast<R>(op(a.values()[k], s)));
+    return result;
+}
+
+// dense op sparse (або sparse op dense з swapped): копія щільного, потім лише збережені індекси
+template<bool Swapped, typename Op, typename E, typename T, std::size_t N>
+auto dense_sparse(const E& dense, const SparseVector<T, N>& sparse, Op op) {
+    static_assert(std::decay_t<E>::dimension == N, "vector dimensions must match");
+    using R = Promote<typename std::decay_t<E>::value_type, T>;
+    VECTOR_COUNT_CALL(instrumentation::op_of<Op>(), N);
+    Vector<R, N> result(dense);
+    const auto& idx = sparse.indices();
+    const auto& val = sparse.values();
+    for (std::size_t k = 0; k < idx.size(); ++k) {
+        R& r = result.at_unchecked(idx[k]);
+        r = Swapped ? static_cast<R>(op(static_cast<R>(val[k]), r)) : static_cast<R>(op(r, static_cast<R>(val[k])));
+    }
+    if constexpr (Swapped) {
+        // Поза збереженими індексами sparse - dense = 0 - x, тож решта елементів змінює знак
+        if constexpr (std::is_same_v<Op, std::minus<>>) {
+            std::size_t k = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (k < idx.size() && idx[k] == i)
+                    ++k;
+                else
+                    result.at_unchecked(i) = static_cast<R>(-result.at_unchecked(i));
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+template<typename T, typename U, std::size_t N>
+auto operator+(const SparseVector<T, N>& a, const SparseVector<U, N>& b) {
+    return detail::sparse_union<Promote<T, U>>(a, b, std::plus<>{});
+}
+
+template<typename T, typename U, std::size_t N>
+auto operator-(const SparseVector<T, N>& a, const SparseVector<U, N>& b) {
+    return detail::sparse_union<Promote<T, U>>(a, b, std::minus<>{});
+}
+
+// Поелементний добуток: лише спільні індекси
+template<typename T, typename U, std::size_t N>
+auto operator*(const SparseVector<T, N>& a, const SparseVector<U, N>& b) {
+    using R = Promote<T, U>;
+    VECTOR_COUNT_CALL(instrumentation::Op::mul, a.nnz() + b.nnz());
+    SparseVector<R, N> result;
+    const auto& ia = a.indices();
+    const auto& ib = b.indices();
+    for (std::size_t i = 0, j = 0; i < ia.size() && j < ib.size();) {
+        if (ia[i] < ib[j]) {
+            ++i;
+        } else if (ib[j] < ia[i]) {
+            ++j;
+        } else {
+            result.push_back(ia[i], static_cast<R>(a.values()[i] * b.values()[j]));
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+template<typename T, std::size_t N, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+auto operator*(const SparseVector<T, N>& a, const U& scalar) {
+    return detail::sparse_scalar<Promote<T, U>>(a, scalar, std::multiplies<>{});
+}
+
+template<typename T, std::size_t N, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+auto operator/(const SparseVector<T, N>& a, const U& scalar) {
+    return detail::sparse_scalar<Promote<T, U>>(a, scalar, std::divides<>{});
+}
+
+// Зі щільним операндом: сума й різниця щільні, добуток зберігає розрідженість
+template<typename T, std::size_t N, typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto operator+(const SparseVector<T, N>& a, const E& b) { return detail::dense_sparse<true>(b, a, std::plus<>{}); }
+
+template<typename E, typename T, std::size_t N, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto operator+(const E& a, const SparseVector<T, N>& b) { return detail::dense_sparse<false>(a, b, std::plus<>{}); }
+
+template<typename T, std::size_t N, typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto operator-(const SparseVector<T, N>& a, const E& b) { return detail::dense_sparse<true>(b, a, std::minus<>{}); }
+
+template<typename E, typename T, std::size_t N, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto operator-(const E& a, const SparseVector<T, N>& b) { return detail::dense_sparse<false>(a, b, std::minus<>{}); }
+
+template<typename T, std::size_t N, typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto operator*(const SparseVector<T, N>& a, const E& b) {
+    static_assert(std::decay_t<E>::dimension == N, "vector dimensions must match");
+    using R = Promote<T, typename std::decay_t<E>::value_type>;
+    VECTOR_COUNT_CALL(instrumentation::Op::mul, a.nnz());
+    SparseVector<R, N> result;
+    result.reserve(a.nnz());
+    for (std::size_t k = 0; k < a.nnz(); ++k)
+        result.push_back(a.indices()[k], static_cast<R>(a.values()[k] * detail::element(b, a.indices()[k])));
+    return result;
+}
+
+template<typename E, typename T, std::size_t N, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto operator*(const E& a, const SparseVector<T, N>& b) { return b * a; }
+
+// Щільний += розріджений: лише збережені елементи
+template<typename T, std::size_t N, std::size_t A, typename U>
+Vector<T, N, A>& operator+=(Vector<T, N, A>& a, const SparseVector<U, N>& b) {
+    return axpy(a, T(1), b);
+}
+
+template<typename T, std::size_t N, std::size_t A, typename U>
+Vector<T, N, A>& operator-=(Vector<T, N, A>& a, const SparseVector<U, N>& b) {
+    return axpy(a, T(-1), b);
+}
+
+// acc = acc + alpha * x за nnz() кроків
+template<typename T, std::size_t N, std::size_t A, typename U, typename V>
+Vector<T, N, A>& axpy(Vector<T, N, A>& acc, const U& alpha, const SparseVector<V, N>& x) {
+    VECTOR_COUNT_CALL(instrumentation::Op::axpy, x.nnz());
+    for (std::size_t k = 0; k < x.nnz(); ++k) {
+        T& r = acc.at_unchecked(x.indices()[k]);
+        r = static_cast<T>(r + alpha * x.values()[k]);
+    }
+    return acc;
+}
+
+// Тип результату - як у weighted_sum для Vector
+template<typename T1, std::size_t N, typename U1, typename T2, typename U2>
+auto weighted_sum(const SparseVector<T1, N>& v1, const U1& alpha, const SparseVector<T2, N>& v2, const U2& beta) {
+    using R1 = std::common_type_t<T1, U1>;
+    using R2 = std::common_type_t<T2, U2>;
+    using R = typename PromoteMultiple<R1, R2>::type;
+    VECTOR_COUNT_CALL(instrumentation::Op::weighted_sum, v1.nnz() + v2.nnz());
+    SparseVector<R, N> result;
+    result.reserve(v1.nnz() + v2.nnz());
+    detail::merge_sparse(v1, v2, [&](std::size_t i, const T1& x, const T2& y) {
+        result.push_back(i, static_cast<R>(alpha * x + beta * y));
+    });
+    return result;
+}
+
+// Скалярний добуток із щільним: збір за індексами в чотири незалежні акумулятори
+template<typename T, std::size_t N, typename E, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto dot(const SparseVector<T, N>& a, const E& b) {
+    static_assert(std::decay_t<E>::dimension == N, "vector dimensions must match");
+    using R = Promote<T, typename std::decay_t<E>::value_type>;
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, a.nnz());
+    const auto& idx = a.indices();
+    const auto& val = a.values();
+    return detail::multi_accumulator_sum<R>(
+        [&](std::size_t k) { return static_cast<R>(static_cast<R>(val[k]) * static_cast<R>(detail::element(b, idx[k]))); },
+        idx.size());
+}
+
+template<typename E, typename T, std::size_t N, std::enable_if_t<is_vector_operand_v<E>, int> = 0>
+auto dot(const E& a, const SparseVector<T, N>& b) { return dot(b, a); }
+
+template<typename T, typename U, std::size_t N>
+auto dot(const SparseVector<T, N>& a, const SparseVector<U, N>& b) {
+    using R = Promote<T, U>;
+    VECTOR_COUNT_CALL(instrumentation::Op::reduce, a.nnz() + b.nnz());
+    const auto& ia = a.indices();
+    const auto& ib = b.indices();
+    R acc{};
+    for (std::size_t i = 0, j = 0; i < ia.size() && j < ib.size();) {
+        if (ia[i] < ib[j]) {
+            ++i;
+        } else if (ib[j] < ia[i]) {
+            ++j;
+        } else {
+            acc += static_cast<R>(a.values()[i]) * static_cast<R>(b.values()[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return acc;
+}
+
+template<typename T, std::size_t N>
+auto sum(const SparseVector<T, N>& v) {
+    using R = Promote<T, T>;
+    return detail::multi_accumulator_sum<R>([&v](std::size_t k) { return static_cast<R>(v.values()[k]); }, v.nnz());
+}
+
+template<typename T, std::size_t N>
+auto squared_norm(const SparseVector<T, N>& v) {
+    using R = Promote<T, T>;
+    return detail::multi_accumulator_sum<R>([&v](std::size_t k) {
+        const R x = static_cast<R>(v.values()[k]);
+        return x * x;
+    }, v.nnz());
+}
+
+template<typename T, std::size_t N>
+auto norm(const SparseVector<T, N>& v) {
+    using F = detail::norm_result_t<Promote<T, T>>;
+    return std::sqrt(static_cast<F>(squared_norm(v)));
+}